@@ -0,0 +1,281 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose:  Illustrates bulk loading of Students from a CSV file, as an alternative to reading one
+//           Student at a time from cin (see ReadData() in Assessments/Chp4-Q1.cpp). The file is mapped
+//           into memory and split into chunks at line boundaries; each chunk is parsed on its own thread
+//           (with std::from_chars for the gpa, so no locale or stream state is involved), and the chunks'
+//           Students are then joined in file order.
+//           Rows are:  firstName,lastName,gpa,course   -- a field may be "quoted", with "" for a quote.
+
+#include <iostream>
+#include <iomanip>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using std::cout;   // preferred to: using namespace std;
+using std::endl;
+using std::string;
+using std::string_view;
+using std::vector;
+
+class Student
+{
+public:
+    string firstName;
+    string lastName;
+    float gpa;
+    string course;
+};
+
+struct CsvResult
+{
+    vector<Student> students;
+    long rejectedRows = 0;   // rows without four fields, or with a gpa that is not (entirely) a number
+    string error;            // empty if the file was read (an empty file included); else why not
+};
+
+// function prototypes
+CsvResult LoadStudentsCsv(const char *, int, bool);
+void Print(const Student &);
+
+// Take the next field of a row, starting at 'next', and advance 'next' past it (and its comma).
+// Returns false at the end of the row, or for a quoted field with no closing quote.
+// Quoted fields are unquoted into 'scratch'.
+bool NextField(const char *&next, const char *end, string_view &field, string &scratch)
+{
+    if (next > end)
+        return false;
+    if (next < end && *next == '"')
+    {
+        scratch.clear();
+        const char *p = next + 1;
+        while (p < end)
+        {
+            if (*p == '"' && p + 1 < end && p[1] == '"')   // "" stands for one quote
+            {
+                scratch.push_back('"');
+                p += 2;
+            }
+            else if (*p == '"')
+                break;
+            else
+                scratch.push_back(*p++);
+        }
+        if (p == end)
+            return false;   // no closing quote: the row is malformed
+        field = scratch;
+        next = p + 1;   // past the closing quote
+        while (next < end && *next != ',')
+            next++;     // (ignore anything between the closing quote and the comma)
+    }
+    else
+    {
+        const char *comma = next;
+        while (comma < end && *comma != ',')
+            comma++;
+        field = string_view(next, comma - next);
+        next = comma;
+    }
+    next++;   // past the comma (or one past the end of the row)
+    return true;
+}
+
+// Parse every complete row in [begin, end) into 'result'
+void ParseChunk(const char *begin, const char *end, CsvResult &result)
+{
+    string firstScratch, lastScratch, gpaScratch, courseScratch;
+    for (const char *row = begin; row < end; )
+    {
+        const char *rowEnd = row;
+        while (rowEnd < end && *rowEnd != '\n')
+            rowEnd++;
+        const char *next = row;
+        const char *fieldsEnd = (rowEnd > row && rowEnd[-1] == '\r') ? rowEnd - 1 : rowEnd;   // CRLF too
+        row = rowEnd + 1;
+        if (fieldsEnd == next)
+            continue;   // a blank line
+
+        string_view first, last, gpaText, course;
+        float gpa = 0.0;
+        std::from_chars_result parsed {};
+        if (!NextField(next, fieldsEnd, first, firstScratch) || !NextField(next, fieldsEnd, last, lastScratch) ||
+            !NextField(next, fieldsEnd, gpaText, gpaScratch) || !NextField(next, fieldsEnd, course, courseScratch) ||
+            next <= fieldsEnd ||   // more than four fields
+            (parsed = std::from_chars(gpaText.data(), gpaText.data() + gpaText.size(), gpa)).ec != std::errc() ||
+            parsed.ptr != gpaText.data() + gpaText.size())   // e.g. "3.7x": trailing characters
+        {
+            result.rejectedRows++;
+            continue;
+        }
+        result.students.push_back(Student{string(first), string(last), gpa, string(course)});
+    }
+}
+
+CsvResult LoadStudentsCsv(const char *path, int threads, bool hasHeader)
+{
+    CsvResult result;
+    int fd = open(path, O_RDONLY);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0)
+    {
+        result.error = string("cannot open ") + path + ": " + std::strerror(errno);
+        if (fd >= 0)
+            close(fd);
+        return result;
+    }
+    if (status.st_size == 0)
+    {
+        close(fd);
+        return result;   // an empty file holds no rows (mmap would refuse a zero length)
+    }
+    size_t size = static_cast<size_t>(status.st_size);
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    int mapError = errno;
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        result.error = string("cannot map ") + path + ": " + std::strerror(mapError);
+        return result;
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    const char *data = static_cast<const char *>(mapping);
+    const char *end = data + size;
+    if (hasHeader)
+        while (data < end && *data++ != '\n')
+            ;
+
+    // Cut [data, end) into roughly equal chunks, moving each cut forward to just past a newline
+    // (a newline never occurs inside a field: quoted fields are single line here)
+    if (threads < 1)
+        threads = 1;
+    vector<const char *> cuts { data };
+    for (int i = 1; i < threads; i++)
+    {
+        const char *cut = data + (end - data) * i / threads;
+        if (cut <= cuts.back())
+            cut = cuts.back();   // already a row boundary
+        else
+            while (cut < end && cut[-1] != '\n')
+                cut++;
+        cuts.push_back(cut);
+    }
+    cuts.push_back(end);
+
+    vector<CsvResult> chunks(threads);
+    vector<std::thread> workers;
+    for (int i = 1; i < threads; i++)
+        workers.emplace_back(ParseChunk, cuts[i], cuts[i + 1], std::ref(chunks[i]));
+    ParseChunk(cuts[0], cuts[1], chunks[0]);   // this thread parses the first chunk
+    for (std::thread &worker : workers)
+        worker.join();
+    munmap(mapping, size);
+
+    size_t total = 0;
+    for (const CsvResult &chunk : chunks)
+        total += chunk.students.size();
+    result.students.reserve(total);
+    for (CsvResult &chunk : chunks)
+    {
+        for (Student &s : chunk.students)
+            result.students.push_back(std::move(s));
+        result.rejectedRows += chunk.rejectedRows;
+    }
+    return result;
+}
+
+void Print(const Student &s)
+{
+    cout << s.firstName << " " << s.lastName << " is taking " << s.course;
+    cout << " and has a gpa of " << std::setprecision(3) << s.gpa << endl;
+}
+
+// The operator>> baseline that mirrors ReadData() in Assessments/Chp4-Q1.cpp, applied to a file:
+// extract each field with the (locale-aware) stream operators
+vector<Student> LoadStudentsStream(const char *path)
+{
+    vector<Student> students;
+    std::ifstream in(path);
+    string line;
+    std::getline(in, line);   // the header
+    Student s;
+    while (std::getline(in, s.firstName, ',') && std::getline(in, s.lastName, ',') &&
+           in >> s.gpa && in.ignore() && std::getline(in, s.course))
+        students.push_back(s);
+    return students;
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    const long rows = argc > 1 ? std::atol(argv[1]) : 2000000;
+    const char *path = "Chp4-Ex8.csv";
+
+    std::ofstream sample(path, std::ios::binary);
+    sample << "firstName,lastName,gpa,course\n"
+           << "Jo,Li,3.7,C++\n"
+           << "\"O\"\"Neil\",\"Smith, Jr.\",3.25,\"Data Structures, Advanced\"\r\n"   // quoting; CRLF
+           << "\n"                                                                    // blank lines are skipped
+           << "Bad,Row,not-a-gpa,C++\n"
+           << "Bad,Gpa,3.7x,C++\n"                                                    // a number, then more
+           << "Bad,Quote,3.1,\"Unclosed\n"                                              // no closing quote
+           << "Sam,Lo,3.5,Java";                                                     // no final newline
+    sample.close();
+    CsvResult loaded = LoadStudentsCsv(path, 2, true);
+    for (const Student &s : loaded.students)
+        Print(s);
+    cout << loaded.students.size() << " students loaded, " << loaded.rejectedRows << " row(s) rejected" << endl;
+    CsvResult missing = LoadStudentsCsv("no-such-file.csv", 2, true);
+    if (!missing.error.empty())
+        cout << "Error: " << missing.error << endl;
+
+    const char *firstNames[] = { "Jo", "Sam", "Ren", "Zack", "Gabby", "Juliet", "Alexandria" };
+    const char *lastNames[] = { "Li", "Lo", "Ze", "Moon", "Doone", "Martinez", "Featherstonehaugh" };
+    const char *courses[] = { "C++", "Java", "Data Structures", "Design Patterns" };
+    FILE *csv = std::fopen(path, "w");
+    if (!csv)
+    {
+        cout << "Error: cannot write " << path << ": " << std::strerror(errno) << endl;
+        return 1;
+    }
+    std::fprintf(csv, "firstName,lastName,gpa,course\n");
+    for (long i = 0; i < rows; i++)
+        std::fprintf(csv, "%s,%s,%.2f,%s\n", firstNames[i % 7], lastNames[i % 7], 2.0 + (i % 200) / 100.0,
+                     courses[i % 4]);
+    std::fclose(csv);
+
+    auto start = std::chrono::steady_clock::now();
+    vector<Student> streamed = LoadStudentsStream(path);
+    double streamSeconds = SecondsSince(start);
+    cout << "Ingest rate for " << rows << " rows (rows/second):" << endl;
+    cout << "   stream extraction (ifstream >>):  " << std::setw(10) << static_cast<long>(streamed.size() / streamSeconds) << endl;
+    int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= (hardware > 4 ? hardware : 4); threads *= 2)
+    {
+        start = std::chrono::steady_clock::now();
+        CsvResult result = LoadStudentsCsv(path, threads, true);
+        double seconds = SecondsSince(start);
+        cout << "   mapped, chunked, " << threads << " thread(s):       " << std::setw(10)
+             << static_cast<long>(result.students.size() / seconds)
+             << (result.students.size() == streamed.size() ? "" : "  (row count differs!)") << endl;
+    }
+
+    std::remove(path);
+    return 0;
+}
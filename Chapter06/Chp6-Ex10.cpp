@@ -0,0 +1,370 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose:  To illustrate a heap-based PriorityQueue as an alternative to the
+//           PriorityQueue of Chp6-Ex4.cpp, whose PriorityEnqueue() requires the caller
+//           to name an existing item and then scans linearly to find it. Here, a d-ary
+//           heap orders items by a comparator template parameter, Push and Pop are
+//           O(log n), and each pushed item is given a Handle through which it may later
+//           be re-prioritized (DecreaseKey) or removed (Erase). A Handle carries a
+//           generation, so one whose item has left the queue is rejected even after its
+//           slot is reused. A HeapPriorityQueue may also be built in O(n) from the
+//           contents of an existing Queue.
+
+#include <iostream>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+using std::cout;
+using std::endl;
+using std::vector;
+
+typedef int Item;
+
+// A trimmed copy of the LinkList-backed Queue from Chp6-Ex4.cpp
+class LinkListElement
+{
+private:
+   void *data = nullptr;
+   LinkListElement *next = nullptr;
+public:
+   LinkListElement(Item *i) : data(i), next(nullptr) { }
+   ~LinkListElement() { delete static_cast<Item *>(data); next = nullptr; }
+   void *GetData() { return data; }
+   LinkListElement *GetNext() const { return next; }
+   void SetNext(LinkListElement *e) { next = e; }
+};
+
+class LinkList
+{
+private:
+   LinkListElement *head = nullptr;
+   LinkListElement *tail = nullptr;
+public:
+   LinkList() = default;
+   LinkList(const LinkList &) = delete;
+   LinkList &operator=(const LinkList &) = delete;
+   ~LinkList() { while (!IsEmpty()) delete RemoveAtFront(); }
+   void InsertAtEnd(Item *);
+   LinkListElement *RemoveAtFront();
+   int IsEmpty() const { return head == nullptr; }
+};
+
+void LinkList::InsertAtEnd(Item *item)
+{
+   LinkListElement *toAdd = new LinkListElement(item);
+   if (!head)
+      head = tail = toAdd;
+   else
+   {
+      tail->SetNext(toAdd);
+      tail = toAdd;
+   }
+}
+
+LinkListElement *LinkList::RemoveAtFront()
+{
+   LinkListElement *remove = head;
+   head = head->GetNext();
+   if (!head)
+      tail = nullptr;
+   return remove;
+}
+
+class Queue : protected LinkList
+{
+public:
+   virtual ~Queue() = default;
+   void Enqueue(Item *i) { InsertAtEnd(i); }
+   Item *Dequeue();
+   int IsEmpty() const { return LinkList::IsEmpty(); }
+};
+
+Item *Queue::Dequeue()
+{
+   LinkListElement *front;
+   front = RemoveAtFront();
+   Item *item = new Item(*(static_cast<Item *>(front->GetData()))); // make copy of front's data
+   delete front;
+   return item;
+}
+
+// Compare(a, b) returns true when a should leave the queue before b; hence the default,
+// std::less, gives a min-heap and "DecreaseKey" moves an item toward the front.
+// Arity is the number of children per heap node; 4 keeps the tree shallow while each
+// node's children still share a cache line or two.
+template <class Type, class Compare = std::less<Type>, int Arity = 4>
+class HeapPriorityQueue
+{
+public:
+   struct Handle
+   {
+      int slot = -1;
+      unsigned generation = 0;   // must match the slot's, else the Handle is stale
+   };
+private:
+   struct Entry
+   {
+      Type data;
+      int slot;
+   };
+   struct Slot
+   {
+      int position;              // that item's index in heap, or -1
+      unsigned generation;       // advanced each time the slot is freed
+   };
+   vector<Entry> heap;
+   vector<Slot> slots;
+   vector<int> freeSlots;
+   Compare before;
+
+   void Place(int index, Entry &&entry) { slots[entry.slot].position = index; heap[index] = std::move(entry); }
+   void SiftUp(int);
+   void SiftDown(int);
+   void RemoveAt(int);
+   Handle NewHandle();
+public:
+   HeapPriorityQueue() = default;
+   explicit HeapPriorityQueue(Compare c) : before(std::move(c)) { }
+   explicit HeapPriorityQueue(Queue &, Compare c = Compare());
+   Handle Push(Type);
+   const Type &Top() const { return heap.front().data; }
+   Type Pop();
+   // each of these returns 0 (and does nothing) if the Handle's item is no longer queued
+   int DecreaseKey(Handle, Type);    // the new value must not be ordered after the old
+   int Update(Handle, Type);         // re-prioritize in either direction
+   int Erase(Handle);
+   int Contains(Handle h) const
+   {
+      return h.slot >= 0 && h.slot < static_cast<int>(slots.size()) &&
+             slots[h.slot].generation == h.generation && slots[h.slot].position >= 0;
+   }
+   int Size() const { return static_cast<int>(heap.size()); }
+   int IsEmpty() const { return heap.empty(); }
+};
+
+// Drain the Queue, then heapify bottom-up (Floyd's method) in O(n); the k-th item
+// dequeued receives Handle{k, 0}
+template <class Type, class Compare, int Arity>
+HeapPriorityQueue<Type, Compare, Arity>::HeapPriorityQueue(Queue &source, Compare c) : before(std::move(c))
+{
+   while (!source.IsEmpty())
+   {
+      Item *item = source.Dequeue();
+      int slot = static_cast<int>(heap.size());
+      heap.push_back(Entry{Type(*item), slot});
+      slots.push_back(Slot{slot, 0});
+      delete item;
+   }
+   if (Size() > 1)   // (an empty or one-item heap is already in order)
+      for (int i = (Size() - 2) / Arity; i >= 0; i--)
+         SiftDown(i);
+}
+
+template <class Type, class Compare, int Arity>
+typename HeapPriorityQueue<Type, Compare, Arity>::Handle HeapPriorityQueue<Type, Compare, Arity>::NewHandle()
+{
+   if (!freeSlots.empty())
+   {
+      int slot = freeSlots.back();
+      freeSlots.pop_back();
+      return Handle{slot, slots[slot].generation};
+   }
+   slots.push_back(Slot{-1, 0});
+   return Handle{static_cast<int>(slots.size() - 1), 0};
+}
+
+// Move the entry at index toward the root until its parent is not ordered after it.
+// The moving entry is held aside so that each level costs one move, not a swap.
+template <class Type, class Compare, int Arity>
+void HeapPriorityQueue<Type, Compare, Arity>::SiftUp(int index)
+{
+   Entry moving = std::move(heap[index]);
+   while (index > 0)
+   {
+      int parent = (index - 1) / Arity;
+      if (!before(moving.data, heap[parent].data))
+         break;
+      Place(index, std::move(heap[parent]));
+      index = parent;
+   }
+   Place(index, std::move(moving));
+}
+
+template <class Type, class Compare, int Arity>
+void HeapPriorityQueue<Type, Compare, Arity>::SiftDown(int index)
+{
+   Entry moving = std::move(heap[index]);
+   int size = Size();
+   for (;;)
+   {
+      int first = index * Arity + 1;
+      if (first >= size)
+         break;
+      int best = first;
+      int last = first + Arity < size ? first + Arity : size;
+      for (int child = first + 1; child < last; child++)
+         if (before(heap[child].data, heap[best].data))
+            best = child;
+      if (!before(heap[best].data, moving.data))
+         break;
+      Place(index, std::move(heap[best]));
+      index = best;
+   }
+   Place(index, std::move(moving));
+}
+
+// Fill the hole at index with the last entry, then restore heap order from there
+template <class Type, class Compare, int Arity>
+void HeapPriorityQueue<Type, Compare, Arity>::RemoveAt(int index)
+{
+   int slot = heap[index].slot;
+   slots[slot].position = -1;
+   slots[slot].generation++;    // outstanding Handles to this slot are now stale
+   freeSlots.push_back(slot);
+   Entry last = std::move(heap.back());
+   heap.pop_back();
+   if (index == Size())
+      return;
+   Place(index, std::move(last));
+   if (index > 0 && before(heap[index].data, heap[(index - 1) / Arity].data))
+      SiftUp(index);
+   else
+      SiftDown(index);
+}
+
+template <class Type, class Compare, int Arity>
+typename HeapPriorityQueue<Type, Compare, Arity>::Handle HeapPriorityQueue<Type, Compare, Arity>::Push(Type item)
+{
+   Handle h = NewHandle();
+   heap.push_back(Entry{std::move(item), h.slot});
+   SiftUp(Size() - 1);
+   return h;
+}
+
+template <class Type, class Compare, int Arity>
+Type HeapPriorityQueue<Type, Compare, Arity>::Pop()
+{
+   Type item = std::move(heap.front().data);
+   RemoveAt(0);
+   return item;
+}
+
+template <class Type, class Compare, int Arity>
+int HeapPriorityQueue<Type, Compare, Arity>::DecreaseKey(Handle h, Type item)
+{
+   if (!Contains(h))
+      return 0;
+   int index = slots[h.slot].position;
+   heap[index].data = std::move(item);
+   SiftUp(index);
+   return 1;
+}
+
+template <class Type, class Compare, int Arity>
+int HeapPriorityQueue<Type, Compare, Arity>::Update(Handle h, Type item)
+{
+   if (!Contains(h))
+      return 0;
+   int index = slots[h.slot].position;
+   heap[index].data = std::move(item);
+   if (index > 0 && before(heap[index].data, heap[(index - 1) / Arity].data))
+      SiftUp(index);
+   else
+      SiftDown(index);
+   return 1;
+}
+
+template <class Type, class Compare, int Arity>
+int HeapPriorityQueue<Type, Compare, Arity>::Erase(Handle h)
+{
+   if (!Contains(h))
+      return 0;
+   RemoveAt(slots[h.slot].position);
+   return 1;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+   HeapPriorityQueue<Item> pq1;
+   pq1.Push(67);
+   HeapPriorityQueue<Item>::Handle h167 = pq1.Push(167);
+   HeapPriorityQueue<Item>::Handle h180 = pq1.Push(180);
+   pq1.Push(100);
+   pq1.DecreaseKey(h167, 50);    // 167 becomes 50 and moves to the front
+   pq1.Erase(h180);
+   HeapPriorityQueue<Item>::Handle h75 = pq1.Push(75);   // reuses 180's slot
+   cout << "Erase via stale handle to 180 succeeds? " << pq1.Erase(h180)
+        << "; 75 still queued? " << pq1.Contains(h75) << endl;
+   cout << "Min-heap order: ";
+   while (!pq1.IsEmpty())
+      cout << pq1.Pop() << " ";
+   cout << endl;
+
+   Queue q1;
+   q1.Enqueue(new Item(50));
+   q1.Enqueue(new Item(67));
+   q1.Enqueue(new Item(80));
+   q1.Enqueue(new Item(12));
+   HeapPriorityQueue<Item, std::greater<Item>> pq2(q1);   // max-heap, heapified in bulk
+   cout << "Max-heap built from a Queue: ";
+   while (!pq2.IsEmpty())
+      cout << pq2.Pop() << " ";
+   cout << endl;
+
+   Queue empty, single;
+   single.Enqueue(new Item(42));
+   HeapPriorityQueue<Item> pqEmpty(empty), pqSingle(single);
+   cout << "Built from an empty Queue: " << pqEmpty.Size() << " items; from a one-item Queue: "
+        << pqSingle.Size() << " item (" << pqSingle.Top() << ")" << endl;
+
+   const int count = 500000;
+   std::mt19937 random(42);
+   vector<Item> keys(count);
+   for (Item &k : keys)
+      k = static_cast<Item>(random() % 1000000000);
+
+   HeapPriorityQueue<Item> pq3;
+   vector<HeapPriorityQueue<Item>::Handle> handles(count);
+   auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < count; i++)
+      handles[i] = pq3.Push(keys[i]);
+   double pushTime = MillisecondsSince(start);
+
+   start = std::chrono::steady_clock::now();
+   for (int i = 0; i < count; i += 2)
+      pq3.DecreaseKey(handles[i], keys[i] / 2);
+   for (int i = 1; i < count; i += 4)
+      pq3.Erase(handles[i]);
+   double updateTime = MillisecondsSince(start);
+
+   start = std::chrono::steady_clock::now();
+   Item previous = -1;
+   int inOrder = 1;
+   while (!pq3.IsEmpty())
+   {
+      Item item = pq3.Pop();
+      inOrder = inOrder && previous <= item;
+      previous = item;
+   }
+   double popTime = MillisecondsSince(start);
+
+   Queue q2;
+   for (int i = 0; i < count; i++)
+      q2.Enqueue(new Item(keys[i]));
+   start = std::chrono::steady_clock::now();
+   HeapPriorityQueue<Item> pq4(q2);
+   double heapifyTime = MillisecondsSince(start);
+
+   cout << count << " items: push " << pushTime << " ms, " << count / 2 << " DecreaseKey + "
+        << count / 4 << " Erase " << updateTime << " ms, pop all " << popTime << " ms"
+        << (inOrder ? "" : " (OUT OF ORDER)") << endl;
+   cout << "Bulk heapify from a Queue of " << pq4.Size() << " items: " << heapifyTime << " ms" << endl;
+
+   return 0;
+}
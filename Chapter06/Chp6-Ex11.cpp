@@ -0,0 +1,185 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose:  To illustrate a bounded, single-producer/single-consumer ring buffer queue
+//           using the Enqueue/Dequeue/IsEmpty vocabulary of the Queue in Chp6-Ex4.cpp.
+//           No allocation occurs after construction. Head and tail indices live on
+//           separate cache lines, and each side caches the other's index so it seldom
+//           needs to read the shared one. Batched EnqueueN/DequeueN are provided, each
+//           in both non-blocking (TryXxx) and blocking forms.
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::size_t;
+
+typedef int Item;
+
+// Exactly one thread may call the Enqueue family, and exactly one thread the Dequeue
+// family. Indices increase without bound and are reduced modulo capacity when used,
+// so full (tail - head == capacity) and empty (tail == head) are distinct.
+class RingBufferQueue
+{
+private:
+   static constexpr size_t CacheLine = 64;
+   const size_t capacity;     // a power of two, so that index & mask == index % capacity
+   const size_t mask;
+   Item *slots;
+   alignas(CacheLine) atomic<size_t> head{0};   // written only by the consumer
+   size_t cachedTail = 0;                        // consumer's last look at tail
+   alignas(CacheLine) atomic<size_t> tail{0};   // written only by the producer
+   size_t cachedHead = 0;                        // producer's last look at head
+   alignas(CacheLine) char padding = 0;          // keep later objects off tail's line
+
+   static size_t RoundUp(size_t);
+public:
+   explicit RingBufferQueue(size_t);
+   RingBufferQueue(const RingBufferQueue &) = delete;
+   RingBufferQueue &operator=(const RingBufferQueue &) = delete;
+   ~RingBufferQueue() { delete [] slots; }
+
+   // producer side
+   int TryEnqueue(const Item &i) { return TryEnqueueN(&i, 1) == 1; }
+   size_t TryEnqueueN(const Item *, size_t);     // returns how many were enqueued
+   void Enqueue(const Item &i) { EnqueueN(&i, 1); }
+   void EnqueueN(const Item *, size_t);          // waits for room for all n
+
+   // consumer side
+   int TryDequeue(Item &i) { return TryDequeueN(&i, 1) == 1; }
+   size_t TryDequeueN(Item *, size_t);           // returns how many were dequeued
+   Item Dequeue() { Item i; DequeueN(&i, 1); return i; }
+   void DequeueN(Item *, size_t);                // waits until n have arrived
+
+   int IsEmpty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+   size_t Capacity() const { return capacity; }
+};
+
+size_t RingBufferQueue::RoundUp(size_t n)
+{
+   size_t power = 1;
+   while (power < n)
+      power <<= 1;
+   return power;
+}
+
+RingBufferQueue::RingBufferQueue(size_t requested) :
+   capacity(RoundUp(requested)), mask(capacity - 1), slots(new Item[capacity])
+{
+}
+
+size_t RingBufferQueue::TryEnqueueN(const Item *items, size_t n)
+{
+   size_t t = tail.load(std::memory_order_relaxed);   // only this thread writes tail
+   size_t room = capacity - (t - cachedHead);
+   if (room < n)
+   {
+      cachedHead = head.load(std::memory_order_acquire);   // refresh only when needed
+      room = capacity - (t - cachedHead);
+   }
+   if (n > room)
+      n = room;
+   for (size_t i = 0; i < n; i++)
+      slots[(t + i) & mask] = items[i];
+   tail.store(t + n, std::memory_order_release);   // publish the whole batch at once
+   return n;
+}
+
+void RingBufferQueue::EnqueueN(const Item *items, size_t n)
+{
+   while (n > 0)
+   {
+      size_t done = TryEnqueueN(items, n);
+      items += done;
+      n -= done;
+      if (n > 0)
+         std::this_thread::yield();   // full; let the consumer run
+   }
+}
+
+size_t RingBufferQueue::TryDequeueN(Item *items, size_t n)
+{
+   size_t h = head.load(std::memory_order_relaxed);   // only this thread writes head
+   size_t available = cachedTail - h;
+   if (available < n)
+   {
+      cachedTail = tail.load(std::memory_order_acquire);
+      available = cachedTail - h;
+   }
+   if (n > available)
+      n = available;
+   for (size_t i = 0; i < n; i++)
+      items[i] = slots[(h + i) & mask];
+   head.store(h + n, std::memory_order_release);
+   return n;
+}
+
+void RingBufferQueue::DequeueN(Item *items, size_t n)
+{
+   while (n > 0)
+   {
+      size_t done = TryDequeueN(items, n);
+      items += done;
+      n -= done;
+      if (n > 0)
+         std::this_thread::yield();   // empty; let the producer run
+   }
+}
+
+// Move 'count' items from one producer thread to one consumer thread in batches of
+// 'batch'; returns items/second and checks that every item arrived in order
+double Transfer(size_t capacity, int count, size_t batch)
+{
+   RingBufferQueue q(capacity);
+   std::vector<Item> in(batch);
+   int ok = 1;
+   auto start = std::chrono::steady_clock::now();
+   std::thread producer([&] {
+      std::vector<Item> buffer(batch);
+      for (int next = 0; next < count; )
+      {
+         size_t n = 0;
+         while (n < batch && next < count)
+            buffer[n++] = next++;
+         q.EnqueueN(buffer.data(), n);
+      }
+   });
+   for (int expected = 0; expected < count; )
+   {
+      size_t n = q.TryDequeueN(in.data(), batch);
+      for (size_t i = 0; i < n; i++)
+         ok = ok && in[i] == expected++;
+      if (n == 0)
+         std::this_thread::yield();
+   }
+   producer.join();
+   double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   if (!ok)
+      cout << "   (items arrived out of order!)" << endl;
+   return count / seconds;
+}
+
+int main()
+{
+   RingBufferQueue q1(4);   // capacity is rounded up to a power of two
+
+   q1.Enqueue(50);
+   q1.Enqueue(67);
+   Item batch[] = {80, 90, 100};
+   size_t accepted = q1.TryEnqueueN(batch, 3);   // only two more fit
+   cout << "Capacity " << q1.Capacity() << "; TryEnqueueN accepted " << accepted << " of 3" << endl;
+   while (!(q1.IsEmpty()))
+      cout << "Dequeued " << q1.Dequeue() << endl;
+   Item item;
+   cout << "TryDequeue on an empty queue succeeded? " << q1.TryDequeue(item) << endl;
+
+   const int count = 10000000;
+   cout << "Items/second, one producer thread to one consumer thread:" << endl;
+   for (size_t batchSize = 1; batchSize <= 256; batchSize *= 16)
+      cout << "   batch " << batchSize << ": " << Transfer(1024, count, batchSize) << endl;
+
+   return 0;
+}
@@ -0,0 +1,508 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose:  To illustrate an ordered, concurrent skip list as a companion to LinkList.
+//           Where LinkList (Chp6-Ex4.cpp) finds an item only by linear search, a skip
+//           list adds express lanes of links so that Insert, Contains and Erase are
+//           O(log n) expected, and ordered range iteration is a walk along the bottom lane.
+//           The design is the "lazy" skip list: searches take no locks at all, while
+//           Insert and Erase lock only the few predecessor nodes they modify.
+//           Erased elements are reclaimed by epochs, once no operation can still reach them.
+//           A benchmark compares it with a mutex-protected std::map.
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <new>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::vector;
+
+typedef int Item;
+
+// Locks are held only for the few instructions that relink an element, so a one-byte
+// spin lock is used rather than a (much larger) std::mutex; this keeps an element's
+// data and its lower links on the same cache line
+class SpinLock
+{
+private:
+   atomic<bool> locked{false};
+public:
+   void lock()
+   {
+      while (locked.exchange(true, std::memory_order_acquire))
+         while (locked.load(std::memory_order_relaxed))
+            std::this_thread::yield();
+   }
+   void unlock() { locked.store(false, std::memory_order_release); }
+};
+
+class alignas(atomic<void *>) SkipListElement   // aligned so the trailing links are too
+{
+private:
+   Item data;
+   int topLevel;                          // this element appears in lanes 0..topLevel
+   atomic<bool> marked{false};            // logically erased
+   atomic<bool> fullyLinked{false};       // linked into every one of its lanes
+   SpinLock lock;
+   atomic<SkipListElement *> *Next() { return reinterpret_cast<atomic<SkipListElement *> *>(this + 1); }
+
+   SkipListElement(const Item &i, int level) : data(i), topLevel(level)
+   {
+      for (int l = 0; l <= level; l++)    // links are stored just past the element
+         new (&Next()[l]) atomic<SkipListElement *>(nullptr);
+   }
+   ~SkipListElement() = default;   // atomic pointers need no destruction
+public:
+   friend class SkipList;
+   // Allocate the element and its links as one block, so that following a link costs
+   // one cache miss rather than two
+   static SkipListElement *Create(const Item &i, int level)
+   {
+      void *memory = ::operator new(sizeof(SkipListElement) + (level + 1) * sizeof(atomic<SkipListElement *>));
+      return new (memory) SkipListElement(i, level);
+   }
+   static void Destroy(SkipListElement *e) { e->~SkipListElement(); ::operator delete(e); }
+   SkipListElement(const SkipListElement &) = delete;
+   SkipListElement &operator=(const SkipListElement &) = delete;
+};
+
+// An EpochRecord belongs to one thread for the duration of one SkipList operation. While
+// the record is active, its epoch announces the global epoch the thread saw on entry. An
+// element unlinked in epoch e waits on the retired list of the record that unlinked it,
+// and is freed once the global epoch reaches e + 2: the epoch only advances when every
+// active record has seen the current one, so by then each operation that could have
+// reached the element has finished. (Hazard pointers, as in Chp6-Ex8.cpp, would need one
+// per pred and succ of every lane, re-validated at each step, on the lock-free search path.)
+// Retired lists stay with the record (not the thread), so nothing is lost at thread exit.
+struct EpochRecord
+{
+   atomic<bool> active{false};
+   atomic<unsigned long long> epoch{0};
+   vector<std::pair<unsigned long long, SkipListElement *>> retired;   // (epoch unlinked, element)
+};
+
+// The head element is a sentinel which precedes every item; a nullptr link stands for
+// the end of a lane. An erased element is unlinked at once, but its memory is reclaimed
+// (see EpochRecord) only when no lock-free reader can still be passing through it.
+class SkipList
+{
+private:
+   static constexpr int MaxLevel = 20;
+   static constexpr int MaxRecords = 64;        // max threads concurrently inside one operation
+   static constexpr size_t ReclaimThreshold = 64;
+   SkipListElement *head = SkipListElement::Create(Item(), MaxLevel);
+   atomic<int> levels{0};                 // lanes in use; searches start from the highest
+   atomic<int> size{0};
+   atomic<unsigned long long> globalEpoch{0};
+   EpochRecord records[MaxRecords];
+
+   // Pins the current epoch for the lifetime of one operation
+   class Pin
+   {
+   private:
+      SkipList &list;
+   public:
+      EpochRecord *record;
+      explicit Pin(SkipList &l) : list(l), record(l.Enter()) { }
+      ~Pin() { list.Leave(record); }
+      Pin(const Pin &) = delete;
+      Pin &operator=(const Pin &) = delete;
+   };
+   EpochRecord *Enter();
+   void Leave(EpochRecord *);
+   void Retire(EpochRecord *, SkipListElement *);
+   void Reclaim(EpochRecord *);
+
+   static int RandomLevel();
+   int Find(const Item &, SkipListElement **, SkipListElement **);
+public:
+   SkipList() { head->fullyLinked.store(true); }
+   SkipList(const SkipList &) = delete;
+   SkipList &operator=(const SkipList &) = delete;
+   ~SkipList();
+   bool Insert(const Item &);        // false if the item is already present
+   bool Erase(const Item &);         // false if the item is not present
+   bool Contains(const Item &);
+   int Size() const { return size.load(); }
+   size_t PendingReclamation() const;   // erased elements not yet freed (call when quiescent)
+   template <class Function>
+   void ForEachInRange(const Item &, const Item &, Function);   // items in [low, high]
+   void Print();
+};
+
+SkipList::~SkipList()
+{
+   SkipListElement *element = head;
+   while (element)
+   {
+      SkipListElement *next = element->Next()[0].load();
+      SkipListElement::Destroy(element);
+      element = next;
+   }
+   // No other thread may use the list now, so reclaim without consulting epochs
+   for (EpochRecord &record : records)
+      for (auto &r : record.retired)
+         SkipListElement::Destroy(r.second);
+}
+
+EpochRecord *SkipList::Enter()
+{
+   thread_local int hint = 0;    // usually re-acquire the same record with one exchange
+   EpochRecord *record = nullptr;
+   for (int i = hint; !record; i = (i + 1) % MaxRecords)
+   {
+      bool expected = false;
+      if (!records[i].active.load(std::memory_order_relaxed) &&
+          records[i].active.compare_exchange_strong(expected, true))
+      {
+         hint = i;
+         record = &records[i];
+      }
+   }
+   // Announce the global epoch, re-reading it to be sure it did not advance (without
+   // seeing this record) before the announcement became visible
+   unsigned long long epoch = globalEpoch.load();
+   for (;;)
+   {
+      record->epoch.store(epoch);
+      unsigned long long again = globalEpoch.load();
+      if (again == epoch)
+         return record;
+      epoch = again;
+   }
+}
+
+void SkipList::Leave(EpochRecord *record)
+{
+   record->active.store(false, std::memory_order_release);
+}
+
+void SkipList::Retire(EpochRecord *record, SkipListElement *element)
+{
+   record->retired.emplace_back(globalEpoch.load(), element);
+   if (record->retired.size() >= ReclaimThreshold)
+      Reclaim(record);
+}
+
+// Advance the global epoch if every active record has seen the current one, then free
+// this record's elements unlinked two or more epochs ago
+void SkipList::Reclaim(EpochRecord *record)
+{
+   unsigned long long epoch = globalEpoch.load();
+   bool everyoneCurrent = true;
+   for (EpochRecord &r : records)
+      if (r.active.load() && r.epoch.load() != epoch)
+         everyoneCurrent = false;
+   if (everyoneCurrent && globalEpoch.compare_exchange_strong(epoch, epoch + 1))
+      epoch++;
+
+   size_t kept = 0;
+   for (auto &r : record->retired)
+   {
+      if (r.first + 2 <= epoch)
+         SkipListElement::Destroy(r.second);
+      else
+         record->retired[kept++] = r;
+   }
+   record->retired.resize(kept);
+}
+
+size_t SkipList::PendingReclamation() const
+{
+   size_t pending = 0;
+   for (const EpochRecord &record : records)
+      pending += record.retired.size();
+   return pending;
+}
+
+// Each additional lane is taken with probability 1/2, so lane l holds ~n/2^l items
+int SkipList::RandomLevel()
+{
+   thread_local std::mt19937 random(std::random_device{}());
+   int level = 0;
+   while (level < MaxLevel && (random() & 1) == 0)
+      level++;
+   return level;
+}
+
+// Fill preds/succs with the elements on either side of item in every lane; return the
+// highest lane in which item itself was found, or -1
+int SkipList::Find(const Item &item, SkipListElement **preds, SkipListElement **succs)
+{
+   int found = -1;
+   SkipListElement *pred = head;
+   int top = levels.load(std::memory_order_relaxed);
+   for (int level = MaxLevel; level > top; level--)   // lanes above 'top' are empty
+   {
+      preds[level] = head;
+      succs[level] = nullptr;
+   }
+   for (int level = top; level >= 0; level--)
+   {
+      SkipListElement *curr = pred->Next()[level].load();
+      while (curr && curr->data < item)
+      {
+         pred = curr;
+         curr = pred->Next()[level].load();
+      }
+      if (found == -1 && curr && curr->data == item)
+         found = level;
+      preds[level] = pred;
+      succs[level] = curr;
+   }
+   return found;
+}
+
+bool SkipList::Contains(const Item &item)
+{
+   Pin pin(*this);
+   SkipListElement *preds[MaxLevel + 1], *succs[MaxLevel + 1];
+   int found = Find(item, preds, succs);
+   return found != -1 && succs[found]->fullyLinked.load() && !succs[found]->marked.load();
+}
+
+bool SkipList::Insert(const Item &item)
+{
+   int topLevel = RandomLevel();
+   int top = levels.load();
+   while (top < topLevel && !levels.compare_exchange_weak(top, topLevel))
+      ;   // raise the search start before linking into a new lane
+   Pin pin(*this);
+   SkipListElement *preds[MaxLevel + 1], *succs[MaxLevel + 1];
+   for (;;)
+   {
+      int found = Find(item, preds, succs);
+      if (found != -1)
+      {
+         SkipListElement *existing = succs[found];
+         if (!existing->marked.load())
+         {
+            while (!existing->fullyLinked.load())   // another Insert is finishing it
+               std::this_thread::yield();
+            return false;
+         }
+         continue;    // it is being erased; try again
+      }
+      // Lock each distinct predecessor, bottom lane upward, then confirm that nothing
+      // changed between the unlocked search and now
+      int highestLocked = -1;
+      SkipListElement *previous = nullptr;
+      bool valid = true;
+      for (int level = 0; valid && level <= topLevel; level++)
+      {
+         SkipListElement *pred = preds[level], *succ = succs[level];
+         if (pred != previous)
+         {
+            pred->lock.lock();
+            highestLocked = level;
+            previous = pred;
+         }
+         valid = !pred->marked.load() && (!succ || !succ->marked.load()) &&
+                 pred->Next()[level].load() == succ;
+      }
+      if (valid)
+      {
+         SkipListElement *element = SkipListElement::Create(item, topLevel);
+         for (int level = 0; level <= topLevel; level++)
+            element->Next()[level].store(succs[level]);
+         for (int level = 0; level <= topLevel; level++)
+            preds[level]->Next()[level].store(element);
+         element->fullyLinked.store(true);
+         size++;
+      }
+      previous = nullptr;
+      for (int level = 0; level <= highestLocked; level++)
+      {
+         if (preds[level] != previous)
+            preds[level]->lock.unlock();
+         previous = preds[level];
+      }
+      if (valid)
+         return true;
+   }
+}
+
+bool SkipList::Erase(const Item &item)
+{
+   SkipListElement *victim = nullptr;
+   bool isMarked = false;
+   int topLevel = -1;
+   Pin pin(*this);
+   SkipListElement *preds[MaxLevel + 1], *succs[MaxLevel + 1];
+   for (;;)
+   {
+      int found = Find(item, preds, succs);
+      if (!isMarked)
+      {
+         if (found == -1)
+            return false;
+         victim = succs[found];
+         // only a fully linked element, found in its own top lane, may be erased
+         if (!victim->fullyLinked.load() || victim->topLevel != found || victim->marked.load())
+            return false;
+         topLevel = victim->topLevel;
+         victim->lock.lock();
+         if (victim->marked.load())   // another Erase won the race
+         {
+            victim->lock.unlock();
+            return false;
+         }
+         victim->marked.store(true);  // logically erased from here on
+         isMarked = true;
+      }
+      int highestLocked = -1;
+      SkipListElement *previous = nullptr;
+      bool valid = true;
+      for (int level = 0; valid && level <= topLevel; level++)
+      {
+         SkipListElement *pred = preds[level];
+         if (pred != previous)
+         {
+            pred->lock.lock();
+            highestLocked = level;
+            previous = pred;
+         }
+         valid = !pred->marked.load() && pred->Next()[level].load() == victim;
+      }
+      if (valid)
+      {
+         for (int level = topLevel; level >= 0; level--)
+            preds[level]->Next()[level].store(victim->Next()[level].load());
+         size--;
+      }
+      previous = nullptr;
+      for (int level = 0; level <= highestLocked; level++)
+      {
+         if (preds[level] != previous)
+            preds[level]->lock.unlock();
+         previous = preds[level];
+      }
+      if (valid)
+      {
+         victim->lock.unlock();
+         Retire(pin.record, victim);
+         return true;
+      }
+   }
+}
+
+// Iteration is weakly consistent: each item present for the whole walk is visited
+// once, in order; items inserted or erased meanwhile may or may not be seen
+template <class Function>
+void SkipList::ForEachInRange(const Item &low, const Item &high, Function f)
+{
+   Pin pin(*this);
+   SkipListElement *preds[MaxLevel + 1], *succs[MaxLevel + 1];
+   Find(low, preds, succs);
+   for (SkipListElement *e = succs[0]; e && !(high < e->data); e = e->Next()[0].load())
+      if (e->fullyLinked.load() && !e->marked.load())
+         f(e->data);
+}
+
+void SkipList::Print()
+{
+   Pin pin(*this);
+   int printed = 0;
+   for (SkipListElement *element = head->Next()[0].load(); element; element = element->Next()[0].load())
+   {
+      if (!element->marked.load())
+      {
+         cout << element->data << " ";
+         printed++;
+      }
+   }
+   if (!printed)
+      cout << "<EMPTY>";    // (even if marked elements are still being unlinked)
+   cout << endl;
+}
+
+class LockedMap
+{
+private:
+   std::mutex lock;
+   std::map<Item, Item> items;
+public:
+   bool Insert(const Item &i) { std::lock_guard<std::mutex> guard(lock); return items.emplace(i, i).second; }
+   bool Erase(const Item &i) { std::lock_guard<std::mutex> guard(lock); return items.erase(i) == 1; }
+   bool Contains(const Item &i) { std::lock_guard<std::mutex> guard(lock); return items.count(i) == 1; }
+};
+
+// Each thread performs 'operations' random operations on keys in [0, keyRange):
+// 80% Contains, 10% Insert, 10% Erase. Returns operations per second.
+template <class Container>
+double RunMixed(Container &container, int threads, int operations, int keyRange)
+{
+   vector<std::thread> workers;
+   auto start = std::chrono::steady_clock::now();
+   for (int t = 0; t < threads; t++)
+   {
+      workers.emplace_back([&, t] {
+         std::mt19937 random(t + 1);
+         for (int i = 0; i < operations; i++)
+         {
+            int choice = random() % 10;
+            Item key = static_cast<Item>(random() % keyRange);
+            if (choice == 0)
+               container.Insert(key);
+            else if (choice == 1)
+               container.Erase(key);
+            else
+               container.Contains(key);
+         }
+      });
+   }
+   for (std::thread &w : workers)
+      w.join();
+   double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   return threads * operations / seconds;
+}
+
+int main()
+{
+   SkipList list1;
+   for (Item i : {50, 10, 80, 30, 67, 10})
+      list1.Insert(i);       // the duplicate 10 is rejected
+   list1.Erase(80);
+   cout << "Skip list (" << list1.Size() << " items): ";
+   list1.Print();
+   cout << "Contains 67? " << list1.Contains(67) << "; contains 80? " << list1.Contains(80) << endl;
+   cout << "Items in [20, 60]: ";
+   list1.ForEachInRange(20, 60, [](const Item &i) { cout << i << " "; });
+   cout << endl;
+
+   SkipList churned;     // steady insert/erase: erased elements are freed as it runs
+   for (int round = 0; round < 1000000; round++)
+   {
+      churned.Insert(round % 1000);
+      churned.Erase((round + 500) % 1000);
+   }
+   cout << "After 1000000 insert/erase rounds, " << churned.PendingReclamation()
+        << " erased elements await reclamation" << endl;
+
+   const int keyRange = 100000, totalOperations = 1000000;
+   int maxThreads = std::max(4u, std::thread::hardware_concurrency());
+   cout << "Operations/second (80% Contains, 10% Insert, 10% Erase):" << endl;
+   for (int threads = 1; threads <= maxThreads; threads *= 2)
+   {
+      SkipList skipList;
+      LockedMap lockedMap;
+      for (Item i = 0; i < keyRange; i += 2)   // start half full
+      {
+         skipList.Insert(i);
+         lockedMap.Insert(i);
+      }
+      double skipRate = RunMixed(skipList, threads, totalOperations / threads, keyRange);
+      double mapRate = RunMixed(lockedMap, threads, totalOperations / threads, keyRange);
+      cout << "   " << threads << " threads: skip list " << skipRate
+           << ", mutex-protected std::map " << mapRate << endl;
+   }
+
+   return 0;
+}
@@ -0,0 +1,273 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose:  To illustrate a LinkList whose LinkListElements are carved from a node pool
+//           (fixed-size slabs threaded with an intrusive free list) rather than
+//           allocated one at a time with new. A small benchmark compares the pool
+//           with the per-node new/delete used in Chp6-Ex2.cpp and Chp6-Ex4.cpp.
+
+#include <iostream>
+#include <chrono>
+#include <new>
+using std::cout;
+using std::endl;
+
+using Item = int;
+
+class LinkListElement
+{
+private:
+   void *data = nullptr;
+   LinkListElement *next = nullptr;
+public:
+   LinkListElement() = default;
+   LinkListElement(Item *i) : data(i), next(nullptr) { }
+   ~LinkListElement() { delete static_cast<Item *>(data); next = nullptr; }
+   void *GetData() { return data; }
+   LinkListElement *GetNext() const { return next; }
+   void SetNext(LinkListElement *e) { next = e; }
+};
+
+// A NodePool hands out raw, suitably aligned memory for one LinkListElement at a time.
+// Memory is obtained from the heap a whole slab at a time; released nodes are threaded
+// onto a free list which is stored inside the released nodes themselves (intrusive), so
+// the pool needs no bookkeeping memory of its own beyond the slab chain.
+class NodePool
+{
+private:
+   static constexpr int ElementsPerSlab = 256;
+   union FreeNode   // a released node is reinterpreted as a link in the free list
+   {
+      FreeNode *next;
+      alignas(LinkListElement) unsigned char storage[sizeof(LinkListElement)];
+   };
+   struct Slab
+   {
+      Slab *nextSlab;
+      FreeNode nodes[ElementsPerSlab];
+   };
+   Slab *slabs = nullptr;        // chain of every slab this pool owns
+   FreeNode *freeList = nullptr; // released nodes, available for reuse
+   int unusedInSlab = 0;         // untouched nodes remaining at the end of slabs
+   void AddSlab();
+public:
+   NodePool() = default;
+   NodePool(const NodePool &) = delete;             // a pool owns its slabs; disallow copies
+   NodePool &operator=(const NodePool &) = delete;  // and assignment
+   ~NodePool() { ReleaseAll(); }
+   void *Allocate();
+   void Release(void *);
+   void ReleaseAll();   // return every slab to the heap at once
+};
+
+void NodePool::AddSlab()
+{
+   Slab *newSlab = static_cast<Slab *>(::operator new(sizeof(Slab)));
+   newSlab->nextSlab = slabs;
+   slabs = newSlab;
+   unusedInSlab = ElementsPerSlab;
+}
+
+void *NodePool::Allocate()
+{
+   if (freeList)     // prefer recently released (and likely cached) nodes
+   {
+      FreeNode *node = freeList;
+      freeList = freeList->next;
+      return node;
+   }
+   if (unusedInSlab == 0)
+      AddSlab();
+   return &slabs->nodes[--unusedInSlab];
+}
+
+void NodePool::Release(void *p)
+{
+   FreeNode *node = static_cast<FreeNode *>(p);
+   node->next = freeList;
+   freeList = node;
+}
+
+void NodePool::ReleaseAll()
+{
+   while (slabs)
+   {
+      Slab *deallocate = slabs;
+      slabs = slabs->nextSlab;
+      ::operator delete(deallocate);
+   }
+   freeList = nullptr;
+   unusedInSlab = 0;
+}
+
+// LinkList now obtains its elements from its own NodePool by default. Passing false to
+// the constructor selects the original per-node new/delete (used below for comparison).
+// Because elements may live in the pool, an element returned from RemoveAtFront() must
+// be handed back with ReleaseElement() rather than with delete.
+class LinkList
+{
+private:
+   LinkListElement *head = nullptr;
+   LinkListElement *tail = nullptr;
+   LinkListElement *current = nullptr;
+   bool pooled = true;
+   NodePool pool;
+   LinkListElement *MakeElement(Item *);
+public:
+   LinkList() = default;
+   explicit LinkList(bool usePool) : pooled(usePool) { }
+   LinkList(const LinkList &) = delete;             // the pool may not be shared
+   LinkList &operator=(const LinkList &) = delete;
+   ~LinkList();
+
+   void InsertAtFront(Item *);
+   LinkListElement *RemoveAtFront();
+   void DeleteAtFront();
+   void ReleaseElement(LinkListElement *);
+
+   void InsertAtEnd(Item *);
+
+   int IsEmpty() const { return head == nullptr; }
+   void Print();
+};
+
+LinkListElement *LinkList::MakeElement(Item *theItem)
+{
+   if (pooled)
+      return new (pool.Allocate()) LinkListElement(theItem);  // placement new into a pool node
+   return new LinkListElement(theItem);
+}
+
+void LinkList::ReleaseElement(LinkListElement *element)
+{
+   if (pooled)
+   {
+      element->~LinkListElement();   // destructor will delete data, set next to nullptr
+      pool.Release(element);
+   }
+   else
+      delete element;
+}
+
+void LinkList::InsertAtFront(Item *theItem)
+{
+   LinkListElement *newHead = MakeElement(theItem);
+
+   newHead->SetNext(head);  // newHead->next = head;
+   head = newHead;
+   if (!tail)
+      tail = head;
+}
+
+LinkListElement *LinkList::RemoveAtFront()
+{
+   LinkListElement *remove = head;
+   head = head->GetNext();  // head = head->next;
+   if (!head)
+      tail = nullptr;
+   current = head;    // reset current for usage elsewhere
+   return remove;
+}
+
+void LinkList::DeleteAtFront()
+{
+   ReleaseElement(RemoveAtFront());
+}
+
+void LinkList::InsertAtEnd(Item *item)
+{
+   if (!head)
+   {
+      head = MakeElement(item);  // constructor also nulls out next
+      tail = head;
+   }
+   else
+   {
+      tail->SetNext(MakeElement(item));
+      tail = tail->GetNext();
+   }
+}
+
+void LinkList::Print()
+{
+   if (!head)
+      cout << "<EMPTY>";
+   current = head;
+   while (current)
+   {
+      Item output;  // localize temp output var
+      output = *(static_cast<Item *>(current->GetData()));
+      cout << output << " ";
+      current = current->GetNext();
+   }
+   cout << endl;
+}
+
+LinkList::~LinkList()
+{
+   if (!pooled)
+   {
+      while (!IsEmpty())
+         DeleteAtFront();
+      return;
+   }
+   // Pooled elements still own their data, so each destructor must run; however, the
+   // nodes need not be threaded back onto the free list one at a time. Instead, the
+   // pool returns its slabs to the heap in bulk.
+   for (current = head; current; )
+   {
+      LinkListElement *next = current->GetNext();
+      current->~LinkListElement();
+      current = next;
+   }
+   head = tail = nullptr;
+   pool.ReleaseAll();
+}
+
+// Grow a list to 'count' elements, then shrink it back to empty, 'rounds' times.
+// Note that each Item is still heap allocated by the caller (the list stores Item *),
+// so only the LinkListElement allocations differ between the two modes.
+double TimeGrowShrink(bool usePool, int count, int rounds)
+{
+   auto start = std::chrono::steady_clock::now();
+   LinkList list(usePool);
+   for (int r = 0; r < rounds; r++)
+   {
+      for (int i = 0; i < count; i++)
+         list.InsertAtEnd(new Item(i));
+      while (!list.IsEmpty())
+         list.DeleteAtFront();
+   }
+   auto stop = std::chrono::steady_clock::now();
+   return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main()
+{
+   LinkList list1;   // uses its NodePool by default
+
+   list1.InsertAtFront(new Item(3000));
+   list1.InsertAtFront(new Item(600));
+   list1.InsertAtEnd(new Item(475));
+   cout << "List 1: ";
+   list1.Print();
+
+   while (!(list1.IsEmpty()))
+   {
+      list1.DeleteAtFront();   // node goes back onto the pool's free list
+      cout << "List 1 after removing an item: ";
+      list1.Print();
+   }
+
+   LinkList list2;
+   for (int i = 0; i < 1000; i++)
+      list2.InsertAtEnd(new Item(i));
+   cout << "List 2 has 1000 items; its slabs are released in bulk by ~LinkList()" << endl;
+
+   const int count = 100000, rounds = 20;
+   double heapTime = TimeGrowShrink(false, count, rounds);
+   double poolTime = TimeGrowShrink(true, count, rounds);
+   cout << "Grow/shrink " << count << " nodes x " << rounds << " rounds" << endl;
+   cout << "   per-node new/delete: " << heapTime << " ms" << endl;
+   cout << "   node pool:           " << poolTime << " ms" << endl;
+
+   return 0;
+}
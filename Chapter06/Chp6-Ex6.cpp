@@ -0,0 +1,430 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose:  To illustrate an unrolled LinkList: each node holds a small, fixed-capacity
+//           array of items rather than a single void * item. Nodes split when an insert
+//           finds them full and merge (or borrow from a neighbor) when removal leaves them
+//           less than half full. Benchmarks compare traversal and middle-insert throughput
+//           against the one-item-per-node LinkList of Chp6-Ex4.cpp.
+
+#include <iostream>
+#include <chrono>
+using std::cout;
+using std::endl;
+
+typedef int Item;
+
+// Items are stored by value in the node, so scanning a node touches one or two cache
+// lines rather than chasing a separate pointer (and a separate Item) per element.
+class UnrolledElement
+{
+private:
+   static constexpr int Capacity = 16;
+   int count = 0;
+   Item items[Capacity];
+   UnrolledElement *next = nullptr;
+public:
+   friend class UnrolledLinkList;
+   UnrolledElement() = default;
+   int IsFull() const { return count == Capacity; }
+   void InsertAt(int, const Item &);
+   void RemoveAt(int);
+   int Find(const Item &) const;
+};
+
+void UnrolledElement::InsertAt(int index, const Item &item)
+{
+   for (int i = count; i > index; i--)   // open a gap at index
+      items[i] = items[i - 1];
+   items[index] = item;
+   count++;
+}
+
+void UnrolledElement::RemoveAt(int index)
+{
+   for (int i = index; i < count - 1; i++)   // close the gap at index
+      items[i] = items[i + 1];
+   count--;
+}
+
+int UnrolledElement::Find(const Item &item) const
+{
+   for (int i = 0; i < count; i++)
+      if (items[i] == item)
+         return i;
+   return -1;
+}
+
+// The public interface mirrors that of LinkList in Chp6-Ex4.cpp. As before, the Item *
+// versions take ownership of the Item passed in; since the value is copied into a node,
+// that Item is deleted immediately. Overloads taking an Item by value avoid the
+// allocation altogether.
+class UnrolledLinkList
+{
+private:
+   UnrolledElement *head = nullptr;
+   UnrolledElement *tail = nullptr;
+   void Split(UnrolledElement *);
+   void RemoveFrom(UnrolledElement *, UnrolledElement *, int);
+   UnrolledElement *Locate(const Item &, UnrolledElement **, int *) const;
+public:
+   UnrolledLinkList() = default;
+   UnrolledLinkList(const UnrolledLinkList &) = delete;
+   UnrolledLinkList &operator=(const UnrolledLinkList &) = delete;
+   ~UnrolledLinkList();
+
+   void InsertAtFront(const Item &);
+   void InsertAtFront(Item *i) { InsertAtFront(*i); delete i; }
+   Item *RemoveAtFront();
+   void DeleteAtFront();
+
+   void InsertBeforeItem(const Item &, const Item &);
+   void InsertBeforeItem(Item *i, Item *existing) { InsertBeforeItem(*i, *existing); delete i; }
+   Item *RemoveSpecificItem(Item *);
+   int DeleteSpecificItem(const Item &);
+
+   void InsertAtEnd(const Item &);
+   void InsertAtEnd(Item *i) { InsertAtEnd(*i); delete i; }
+
+   int IsEmpty() const { return head == nullptr; }
+   long long Sum() const;
+   void Print() const;
+};
+
+// Move the upper half of a full node into a new node which follows it
+void UnrolledLinkList::Split(UnrolledElement *node)
+{
+   UnrolledElement *newNode = new UnrolledElement;
+   int half = node->count / 2;
+   for (int i = half; i < node->count; i++)
+      newNode->items[newNode->count++] = node->items[i];
+   node->count = half;
+   newNode->next = node->next;
+   node->next = newNode;
+   if (tail == node)
+      tail = newNode;
+}
+
+// Find the node (and index within it) holding item; also report the preceding node
+UnrolledElement *UnrolledLinkList::Locate(const Item &item, UnrolledElement **prev, int *index) const
+{
+   UnrolledElement *before = nullptr;
+   for (UnrolledElement *node = head; node; before = node, node = node->next)
+   {
+      int i = node->Find(item);
+      if (i >= 0)
+      {
+         *prev = before;
+         *index = i;
+         return node;
+      }
+   }
+   return nullptr;
+}
+
+void UnrolledLinkList::InsertAtFront(const Item &item)
+{
+   if (!head || head->IsFull())
+   {
+      UnrolledElement *newHead = new UnrolledElement;
+      newHead->next = head;
+      head = newHead;
+      if (!tail)
+         tail = head;
+   }
+   head->InsertAt(0, item);
+}
+
+void UnrolledLinkList::InsertAtEnd(const Item &item)
+{
+   if (!tail || tail->IsFull())
+   {
+      UnrolledElement *newTail = new UnrolledElement;
+      if (tail)
+         tail->next = newTail;
+      else
+         head = newTail;
+      tail = newTail;
+   }
+   tail->InsertAt(tail->count, item);
+}
+
+void UnrolledLinkList::InsertBeforeItem(const Item &newItem, const Item &existing)
+{
+   UnrolledElement *prev = nullptr;
+   int index = 0;
+   UnrolledElement *node = Locate(existing, &prev, &index);
+   if (!node)     // unlike Chp6-Ex4.cpp, tolerate a missing item by appending
+   {
+      InsertAtEnd(newItem);
+      return;
+   }
+   if (node->IsFull())
+   {
+      Split(node);
+      if (index > node->count)   // existing item moved into the new node
+      {
+         index -= node->count;
+         node = node->next;
+      }
+   }
+   node->InsertAt(index, newItem);
+}
+
+// Remove items[index] from node, then keep nodes at least half full by merging with,
+// or borrowing from, the following node
+void UnrolledLinkList::RemoveFrom(UnrolledElement *prev, UnrolledElement *node, int index)
+{
+   node->RemoveAt(index);
+   if (node->count == 0)
+   {
+      if (prev)
+         prev->next = node->next;
+      else
+         head = node->next;
+      if (tail == node)
+         tail = prev;
+      delete node;
+      return;
+   }
+   UnrolledElement *next = node->next;
+   if (node->count >= UnrolledElement::Capacity / 2 || !next)
+      return;
+   if (node->count + next->count <= UnrolledElement::Capacity)
+   {
+      for (int i = 0; i < next->count; i++)     // merge next into node
+         node->items[node->count++] = next->items[i];
+      node->next = next->next;
+      if (tail == next)
+         tail = node;
+      delete next;
+   }
+   else
+   {
+      while (node->count < UnrolledElement::Capacity / 2)   // borrow from next
+      {
+         node->items[node->count++] = next->items[0];
+         next->RemoveAt(0);
+      }
+   }
+}
+
+Item *UnrolledLinkList::RemoveAtFront()
+{
+   Item *item = new Item(head->items[0]);   // as Queue::Dequeue, hand back a copy
+   RemoveFrom(nullptr, head, 0);
+   return item;
+}
+
+void UnrolledLinkList::DeleteAtFront()
+{
+   RemoveFrom(nullptr, head, 0);
+}
+
+Item *UnrolledLinkList::RemoveSpecificItem(Item *item)
+{
+   UnrolledElement *prev = nullptr;
+   int index = 0;
+   UnrolledElement *node = Locate(*item, &prev, &index);
+   if (!node)
+      return nullptr;
+   Item *removed = new Item(node->items[index]);
+   RemoveFrom(prev, node, index);
+   return removed;
+}
+
+int UnrolledLinkList::DeleteSpecificItem(const Item &item)
+{
+   UnrolledElement *prev = nullptr;
+   int index = 0;
+   UnrolledElement *node = Locate(item, &prev, &index);
+   if (!node)
+      return 0;
+   RemoveFrom(prev, node, index);
+   return 1;
+}
+
+long long UnrolledLinkList::Sum() const
+{
+   long long sum = 0;
+   for (UnrolledElement *node = head; node; node = node->next)
+      for (int i = 0; i < node->count; i++)
+         sum += node->items[i];
+   return sum;
+}
+
+void UnrolledLinkList::Print() const
+{
+   if (!head)
+      cout << "<EMPTY>";
+   for (UnrolledElement *node = head; node; node = node->next)
+   {
+      cout << "[ ";
+      for (int i = 0; i < node->count; i++)
+         cout << node->items[i] << " ";
+      cout << "] ";
+   }
+   cout << endl;
+}
+
+UnrolledLinkList::~UnrolledLinkList()
+{
+   while (head)
+   {
+      UnrolledElement *deallocate = head;
+      head = head->next;
+      delete deallocate;
+   }
+}
+
+// A trimmed copy of the one-item-per-node LinkList from Chp6-Ex4.cpp, kept here so
+// that the two representations may be timed against one another.
+class LinkListElement
+{
+private:
+   void *data = nullptr;
+   LinkListElement *next = nullptr;
+public:
+   LinkListElement(Item *i) : data(i), next(nullptr) { }
+   ~LinkListElement() { delete static_cast<Item *>(data); next = nullptr; }
+   void *GetData() { return data; }
+   LinkListElement *GetNext() const { return next; }
+   void SetNext(LinkListElement *e) { next = e; }
+};
+
+class LinkList
+{
+private:
+   LinkListElement *head = nullptr;
+   LinkListElement *tail = nullptr;
+public:
+   LinkList() = default;
+   LinkList(const LinkList &) = delete;
+   LinkList &operator=(const LinkList &) = delete;
+   ~LinkList();
+   void InsertAtFront(Item *);
+   void InsertBeforeItem(Item *, Item *);
+   void InsertAtEnd(Item *);
+   long long Sum() const;
+};
+
+void LinkList::InsertAtFront(Item *theItem)
+{
+   LinkListElement *newHead = new LinkListElement(theItem);
+   newHead->SetNext(head);
+   head = newHead;
+   if (!tail)
+      tail = head;
+}
+
+void LinkList::InsertBeforeItem(Item *newItem, Item *existing)
+{
+   LinkListElement *temp = nullptr, *current = head;
+   if (*(static_cast<Item *>(current->GetData())) == *existing)
+      InsertAtFront(newItem);
+   else
+   {
+      while (*(static_cast<Item *>(current->GetData())) != *existing)
+      {
+         temp = current;
+         current = current->GetNext();
+      }
+      LinkListElement *toAdd = new LinkListElement(newItem);
+      temp->SetNext(toAdd);
+      toAdd->SetNext(current);
+   }
+}
+
+void LinkList::InsertAtEnd(Item *item)
+{
+   if (!head)
+      head = tail = new LinkListElement(item);
+   else
+   {
+      tail->SetNext(new LinkListElement(item));
+      tail = tail->GetNext();
+   }
+}
+
+long long LinkList::Sum() const
+{
+   long long sum = 0;
+   for (LinkListElement *e = head; e; e = e->GetNext())
+      sum += *(static_cast<Item *>(e->GetData()));
+   return sum;
+}
+
+LinkList::~LinkList()
+{
+   while (head)
+   {
+      LinkListElement *deallocate = head;
+      head = head->GetNext();
+      delete deallocate;
+   }
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+   UnrolledLinkList list1;
+   for (int i = 1; i <= 20; i++)
+      list1.InsertAtEnd(new Item(i * 10));
+   list1.InsertAtFront(new Item(5));
+   Item existing = 100;
+   list1.InsertBeforeItem(new Item(95), &existing);   // splits a full node
+   cout << "List 1 (nodes shown in brackets): ";
+   list1.Print();
+
+   for (int i = 1; i <= 14; i++)
+   {
+      Item target = i * 10;
+      delete list1.RemoveSpecificItem(&target);   // nodes merge as they empty out
+   }
+   cout << "List 1 after removing 10..140: ";
+   list1.Print();
+   while (!list1.IsEmpty())
+      list1.DeleteAtFront();
+   cout << "List 1 emptied: ";
+   list1.Print();
+
+   const int count = 20000, inserts = 2000, traversals = 200;
+   LinkList classic;
+   UnrolledLinkList unrolled;
+   for (int i = 0; i < count; i++)
+   {
+      classic.InsertAtEnd(new Item(i));
+      unrolled.InsertAtEnd(i);
+   }
+
+   long long check1 = 0, check2 = 0;
+   auto start = std::chrono::steady_clock::now();
+   for (int t = 0; t < traversals; t++)
+      check1 += classic.Sum();
+   double classicTraverse = MillisecondsSince(start);
+   start = std::chrono::steady_clock::now();
+   for (int t = 0; t < traversals; t++)
+      check2 += unrolled.Sum();
+   double unrolledTraverse = MillisecondsSince(start);
+
+   Item middle = count / 2;
+   start = std::chrono::steady_clock::now();
+   for (int i = 0; i < inserts; i++)
+      classic.InsertBeforeItem(new Item(-i), &middle);
+   double classicInsert = MillisecondsSince(start);
+   start = std::chrono::steady_clock::now();
+   for (int i = 0; i < inserts; i++)
+      unrolled.InsertBeforeItem(-i, middle);
+   double unrolledInsert = MillisecondsSince(start);
+
+   cout << "Traverse " << count << " items x " << traversals << ": LinkList " << classicTraverse
+        << " ms, UnrolledLinkList " << unrolledTraverse << " ms"
+        << (check1 == check2 ? "" : " (MISMATCH)") << endl;
+   cout << "Insert " << inserts << " items mid-list: LinkList " << classicInsert
+        << " ms, UnrolledLinkList " << unrolledInsert << " ms"
+        << (classic.Sum() == unrolled.Sum() ? "" : " (MISMATCH)") << endl;
+
+   return 0;
+}
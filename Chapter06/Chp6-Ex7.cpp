@@ -0,0 +1,409 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose:  To illustrate an optional indexed mode for the LinkList of Chp6-Ex4.cpp.
+//           Each LinkListElement gains a back-link (prev), and an indexed LinkList also
+//           keeps a hash map from item value to the elements holding that value, in list
+//           order. Find, InsertBeforeItem, RemoveSpecificItem and RemoveAtEnd then run in
+//           O(1) (plus O(log d) to place an element among d equal items), so the
+//           PriorityQueue::PriorityEnqueue path no longer degrades with queue length.
+
+#include <iostream>
+#include <chrono>
+#include <set>
+#include <unordered_map>
+using std::cout;
+using std::endl;
+using std::set;
+using std::unordered_map;
+
+typedef int Item;
+
+class LinkListElement;
+
+struct EarlierInList    // orders elements of one list by position (see LinkListElement::order)
+{
+   bool operator()(const LinkListElement *, const LinkListElement *) const;
+};
+
+typedef set<LinkListElement *, EarlierInList> SameValueChain;
+
+class LinkListElement
+{
+private:
+   void *data = nullptr;
+   LinkListElement *next = nullptr;
+   LinkListElement *prev = nullptr;   // back-link makes unlinking O(1)
+   // Used only in an indexed LinkList: labels increasing from head to tail, so that two
+   // elements' positions compare in O(1), and this element's place in its value's chain
+   unsigned long long order = 0;
+   SameValueChain::iterator sameValue;
+public:
+   LinkListElement() = default;
+   LinkListElement(Item *i) : data(i), next(nullptr), prev(nullptr) { }
+   ~LinkListElement() { delete static_cast<Item *>(data); next = prev = nullptr; }
+   void *GetData() { return data; }
+   LinkListElement *GetNext() const { return next; }
+   void SetNext(LinkListElement *e) { next = e; }
+   LinkListElement *GetPrev() const { return prev; }
+   void SetPrev(LinkListElement *e) { prev = e; }
+   unsigned long long GetOrder() const { return order; }
+   void SetOrder(unsigned long long o) { order = o; }
+   SameValueChain::iterator GetSameValue() const { return sameValue; }
+   void SetSameValue(SameValueChain::iterator i) { sameValue = i; }
+};
+
+inline bool EarlierInList::operator()(const LinkListElement *e1, const LinkListElement *e2) const
+{
+   return e1->GetOrder() < e2->GetOrder();
+}
+
+// When constructed with indexed = true, LinkList maintains 'index' alongside the list.
+// Items with equal values may appear more than once; each value's chain is kept in list
+// order, so indexed lookups select the matching element closest to the head, as a scan does.
+class LinkList
+{
+private:
+   static constexpr unsigned long long OrderLimit = 1ULL << 63;  // labels lie in (0, OrderLimit)
+   static constexpr unsigned long long OrderGap = 1ULL << 32;    // spacing for appended elements
+   LinkListElement *head = nullptr;
+   LinkListElement *tail = nullptr;
+   LinkListElement *current = nullptr;
+   bool indexed = false;
+   unordered_map<Item, SameValueChain> index;
+   void LinkBefore(LinkListElement *, LinkListElement *);
+   void Unlink(LinkListElement *);
+   void Label(LinkListElement *);
+   void Relabel(LinkListElement *);
+   void Unindex(LinkListElement *);
+public:
+   LinkList() = default;
+   explicit LinkList(bool useIndex) : indexed(useIndex) { }
+   LinkList(const LinkList &) = delete;
+   LinkList &operator=(const LinkList &) = delete;
+   ~LinkList();
+
+   LinkListElement *Find(Item *);
+
+   void InsertAtFront(Item *);
+   LinkListElement *RemoveAtFront();
+   void DeleteAtFront();
+
+   void InsertBeforeItem(Item *, Item *);
+   LinkListElement *RemoveSpecificItem(Item *);
+   void DeleteSpecificItem(Item *);
+
+   void InsertAtEnd(Item *);
+   LinkListElement *RemoveAtEnd();
+   void DeleteAtEnd();
+
+   int IsEmpty() const { return head == nullptr; }
+   void Print();
+};
+
+// Link toAdd in before 'before' (or at the end of the list if 'before' is nullptr)
+void LinkList::LinkBefore(LinkListElement *toAdd, LinkListElement *before)
+{
+   LinkListElement *after = before ? before->GetPrev() : tail;
+   toAdd->SetPrev(after);
+   toAdd->SetNext(before);
+   if (after)
+      after->SetNext(toAdd);
+   else
+      head = toAdd;
+   if (before)
+      before->SetPrev(toAdd);
+   else
+      tail = toAdd;
+   if (indexed)
+   {
+      Label(toAdd);
+      SameValueChain &chain = index[*(static_cast<Item *>(toAdd->GetData()))];
+      toAdd->SetSameValue(chain.insert(toAdd).first);
+   }
+}
+
+// Give a newly linked element an order label between those of its neighbours
+void LinkList::Label(LinkListElement *element)
+{
+   LinkListElement *after = element->GetPrev(), *before = element->GetNext();
+   unsigned long long low = after ? after->GetOrder() : 0;
+   unsigned long long high = before ? before->GetOrder() : OrderLimit;
+   if (!after && !before)
+      element->SetOrder(OrderLimit / 2);
+   else if (!before && high - low > OrderGap)
+      element->SetOrder(low + OrderGap);     // appending leaves room for the next append
+   else if (!after && high > OrderGap)
+      element->SetOrder(high - OrderGap);
+   else if (high - low >= 2)
+      element->SetOrder(low + (high - low) / 2);
+   else
+      Relabel(element);
+}
+
+// No label fits between element's neighbours: spread labels evenly over the smallest window
+// around element (doubling it each try) whose label range leaves room for later inserts.
+// Relabelling keeps the elements' relative order, so every SameValueChain stays sorted.
+void LinkList::Relabel(LinkListElement *element)
+{
+   const unsigned long long MinGap = 1ULL << 16;
+   LinkListElement *first = element, *last = element;
+   unsigned long long count = 1;
+   for (;;)
+   {
+      for (unsigned long long i = 0, n = count; i < n; i++)
+      {
+         if (first->GetPrev())
+         {
+            first = first->GetPrev();
+            count++;
+         }
+         if (last->GetNext())
+         {
+            last = last->GetNext();
+            count++;
+         }
+      }
+      unsigned long long low = first->GetPrev() ? first->GetPrev()->GetOrder() : 0;
+      unsigned long long high = last->GetNext() ? last->GetNext()->GetOrder() : OrderLimit;
+      unsigned long long gap = (high - low) / (count + 1);
+      if (gap >= MinGap || (!first->GetPrev() && !last->GetNext()))   // (or the window is the whole list)
+      {
+         for (LinkListElement *e = first; e != last->GetNext(); e = e->GetNext())
+            e->SetOrder(low += gap);
+         return;
+      }
+   }
+}
+
+void LinkList::Unindex(LinkListElement *element)
+{
+   auto chain = index.find(*(static_cast<Item *>(element->GetData())));
+   chain->second.erase(element->GetSameValue());    // O(1): the element knows its place
+   if (chain->second.empty())
+      index.erase(chain);
+}
+
+void LinkList::Unlink(LinkListElement *element)
+{
+   if (indexed)
+      Unindex(element);     // (while element's order label is still its own)
+   if (element->GetPrev())
+      element->GetPrev()->SetNext(element->GetNext());
+   else
+      head = element->GetNext();
+   if (element->GetNext())
+      element->GetNext()->SetPrev(element->GetPrev());
+   else
+      tail = element->GetPrev();
+   element->SetNext(nullptr);
+   element->SetPrev(nullptr);
+   current = head;    // reset current for usage elsewhere
+}
+
+LinkListElement *LinkList::Find(Item *item)
+{
+   if (indexed)
+   {
+      auto found = index.find(*item);
+      return found == index.end() ? nullptr : *(found->second.begin());   // nearest the head
+   }
+   for (current = head; current; current = current->GetNext())
+      if (*(static_cast<Item *>(current->GetData())) == *item)
+         return current;
+   return nullptr;
+}
+
+void LinkList::InsertAtFront(Item *theItem)
+{
+   LinkBefore(new LinkListElement(theItem), head);
+}
+
+LinkListElement *LinkList::RemoveAtFront()
+{
+   LinkListElement *remove = head;
+   Unlink(remove);
+   return remove;
+}
+
+void LinkList::DeleteAtFront()
+{
+   delete RemoveAtFront();    // destructor will delete data, null out links
+}
+
+void LinkList::InsertBeforeItem(Item *newItem, Item *existing)
+{
+   // assumes item to insert before exists
+   LinkBefore(new LinkListElement(newItem), Find(existing));
+}
+
+LinkListElement *LinkList::RemoveSpecificItem(Item *item)
+{
+   LinkListElement *remove = Find(item);
+   if (remove)
+      Unlink(remove);
+   return remove;
+}
+
+void LinkList::DeleteSpecificItem(Item *item)
+{
+   delete RemoveSpecificItem(item);   // deleting a nullptr is harmless
+}
+
+void LinkList::InsertAtEnd(Item *item)
+{
+   LinkBefore(new LinkListElement(item), nullptr);
+}
+
+LinkListElement *LinkList::RemoveAtEnd()
+{
+   LinkListElement *remove = tail;   // tail->prev replaces the walk from head
+   Unlink(remove);
+   return remove;
+}
+
+void LinkList::DeleteAtEnd()
+{
+   delete RemoveAtEnd();
+}
+
+void LinkList::Print()
+{
+   if (!head)
+      cout << "<EMPTY>";
+   current = head;
+   while (current)
+   {
+      Item output;  // localize temp output var
+      output = *(static_cast<Item *>(current->GetData()));
+      cout << output << " ";
+      current = current->GetNext();
+   }
+   cout << endl;
+}
+
+LinkList::~LinkList()
+{
+   index.clear();     // no need to unindex elements one at a time
+   indexed = false;
+   while (!IsEmpty())
+      DeleteAtFront();
+}
+
+class Queue : protected LinkList
+{
+public:
+   Queue() = default;
+   explicit Queue(bool useIndex) : LinkList(useIndex) { }
+   virtual ~Queue() = default;
+   void Enqueue(Item *i) { InsertAtEnd(i); }
+   Item *Dequeue();
+   int IsEmpty() const { return LinkList::IsEmpty(); }
+   void Print() { LinkList::Print(); }
+};
+
+Item *Queue::Dequeue()
+{
+   LinkListElement *front;
+   front = RemoveAtFront();
+   Item *item = new Item(*(static_cast<Item *>(front->GetData()))); // make copy of front's data
+   delete front;
+   return item;
+}
+
+class PriorityQueue : public Queue
+{
+public:
+   PriorityQueue() : Queue(true) { }   // a PriorityQueue is indexed by default
+   explicit PriorityQueue(bool useIndex) : Queue(useIndex) { }
+   ~PriorityQueue() override = default;
+   void PriorityEnqueue(Item *i1, Item *i2) { InsertBeforeItem(i1, i2); }
+   void Withdraw(Item *i) { DeleteSpecificItem(i); }
+};
+
+// Build a queue of 'length' items, then priority-enqueue 'count' items in front of the
+// item nearest the back of the queue (the worst case for a linear scan)
+double TimePriorityEnqueue(bool useIndex, int length, int count)
+{
+   PriorityQueue q(useIndex);
+   for (int i = 0; i < length; i++)
+      q.Enqueue(new Item(i));
+   Item existing = length - 1;
+   auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < count; i++)
+      q.PriorityEnqueue(new Item(length + i), &existing);
+   auto stop = std::chrono::steady_clock::now();
+   return std::chrono::duration<double, std::micro>(stop - start).count() / count;
+}
+
+// Enqueue 'length' items drawn from just 'distinct' priorities, then dequeue them all
+double TimeDrain(bool useIndex, int length, int distinct)
+{
+   PriorityQueue q(useIndex);
+   for (int i = 0; i < length; i++)
+      q.Enqueue(new Item(i % distinct));
+   auto start = std::chrono::steady_clock::now();
+   while (!q.IsEmpty())
+      delete q.Dequeue();
+   auto stop = std::chrono::steady_clock::now();
+   return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main()
+{
+   PriorityQueue q1;
+
+   Item *item = new Item(167);
+   q1.Enqueue(new Item(67));
+   q1.Enqueue(item);
+   q1.Enqueue(new Item(180));
+   q1.PriorityEnqueue(new Item(100), item); // add new item before existing one
+   q1.Print();
+
+   Item gone = 180;
+   q1.Withdraw(&gone);     // O(1) removal of a specific item
+   q1.Print();
+
+   while (!(q1.IsEmpty()))
+   {
+      delete q1.Dequeue();
+      q1.Print();
+   }
+
+   LinkList list1(true);
+   for (int i = 1; i <= 5; i++)
+      list1.InsertAtEnd(new Item(i * 11));
+   list1.DeleteAtEnd();     // O(1) via back-links
+   Item target = 22;
+   list1.DeleteSpecificItem(&target);
+   cout << "List 1: ";
+   list1.Print();
+
+   // with duplicates, indexed and plain lists act on the same (first) matching element
+   LinkList plain, indexed(true);
+   for (int i = 0; i < 6; i++)
+   {
+      plain.InsertAtEnd(new Item(i % 3));
+      indexed.InsertAtEnd(new Item(i % 3));
+   }
+   Item one = 1, two = 2;
+   plain.InsertBeforeItem(new Item(9), &two);
+   indexed.InsertBeforeItem(new Item(9), &two);
+   plain.DeleteSpecificItem(&one);
+   indexed.DeleteSpecificItem(&one);
+   cout << "Plain:   ";
+   plain.Print();
+   cout << "Indexed: ";
+   indexed.Print();
+
+   cout << "Draining 40000 items of 4 priorities (milliseconds): linear scan " << TimeDrain(false, 40000, 4)
+        << ", indexed " << TimeDrain(true, 40000, 4) << endl;
+
+   const int count = 1000;
+   cout << "Average PriorityEnqueue cost (microseconds) by queue length:" << endl;
+   for (int length = 1000; length <= 100000; length *= 10)
+   {
+      cout << "   " << length << " items: linear scan " << TimePriorityEnqueue(false, length, count)
+           << ", indexed " << TimePriorityEnqueue(true, length, count) << endl;
+   }
+
+   return 0;
+}
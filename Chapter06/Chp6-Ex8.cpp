@@ -0,0 +1,364 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose:  To illustrate a lock-free, multi-producer/multi-consumer Queue offering the
+//           Enqueue/Dequeue/IsEmpty interface of the Queue in Chp6-Ex4.cpp. The design is
+//           the Michael-Scott linked queue; removed nodes are reclaimed safely using
+//           hazard pointers. Dequeue returns the Item by value (no copy is allocated).
+//           A benchmark scales producer/consumer thread pairs against a mutex-guarded
+//           version of the LinkList-backed Queue.
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::optional;
+using std::vector;
+
+typedef int Item;
+
+// A HazardRecord belongs to one thread for the duration of one Queue operation. Its
+// hazard pointers announce which nodes that thread may still dereference; nodes that
+// thread has unlinked wait on its retired list until no hazard pointer refers to them.
+// Retired lists stay with the record (not the thread), so nothing is lost at thread exit.
+struct HazardRecord
+{
+   atomic<bool> active{false};
+   atomic<void *> hazard[2] = {nullptr, nullptr};
+   vector<void *> retired;
+};
+
+class LockFreeQueue
+{
+private:
+   struct Node
+   {
+      Item data{};
+      atomic<Node *> next{nullptr};
+      Node() = default;
+      explicit Node(const Item &i) : data(i) { }
+   };
+   static constexpr int MaxRecords = 64;    // max threads concurrently inside one operation
+   static constexpr size_t ScanThreshold = 2 * MaxRecords * 2;
+   alignas(64) atomic<Node *> head;         // keep head and tail on separate cache lines
+   alignas(64) atomic<Node *> tail;
+   HazardRecord records[MaxRecords];
+
+   HazardRecord *AcquireRecord();
+   void ReleaseRecord(HazardRecord *);
+   Node *Protect(const atomic<Node *> &, HazardRecord *, int);
+   void Retire(HazardRecord *, Node *);
+   void Scan(HazardRecord *);
+public:
+   LockFreeQueue();
+   LockFreeQueue(const LockFreeQueue &) = delete;
+   LockFreeQueue &operator=(const LockFreeQueue &) = delete;
+   ~LockFreeQueue();
+   void Enqueue(const Item &);
+   optional<Item> Dequeue();
+   int IsEmpty();
+};
+
+LockFreeQueue::LockFreeQueue()
+{
+   Node *dummy = new Node;    // head always points to a dummy node
+   head.store(dummy);
+   tail.store(dummy);
+}
+
+LockFreeQueue::~LockFreeQueue()
+{
+   // No other thread may use the queue now, so reclaim without consulting hazards
+   for (HazardRecord &record : records)
+      for (void *p : record.retired)
+         delete static_cast<Node *>(p);
+   Node *node = head.load();
+   while (node)
+   {
+      Node *next = node->next.load();
+      delete node;
+      node = next;
+   }
+}
+
+HazardRecord *LockFreeQueue::AcquireRecord()
+{
+   thread_local int hint = 0;    // usually re-acquire the same record with one exchange
+   for (int i = hint; ; i = (i + 1) % MaxRecords)
+   {
+      bool expected = false;
+      if (!records[i].active.load(std::memory_order_relaxed) &&
+          records[i].active.compare_exchange_strong(expected, true))
+      {
+         hint = i;
+         return &records[i];
+      }
+   }
+}
+
+void LockFreeQueue::ReleaseRecord(HazardRecord *record)
+{
+   record->hazard[0].store(nullptr);
+   record->hazard[1].store(nullptr);
+   record->active.store(false, std::memory_order_release);
+}
+
+// Publish a hazard pointer to the node currently held by src, re-reading src to be sure
+// the node was not unlinked (and possibly reclaimed) before the hazard became visible
+LockFreeQueue::Node *LockFreeQueue::Protect(const atomic<Node *> &src, HazardRecord *record, int slot)
+{
+   Node *p = src.load();
+   for (;;)
+   {
+      record->hazard[slot].store(p);
+      Node *again = src.load();
+      if (again == p)
+         return p;
+      p = again;
+   }
+}
+
+void LockFreeQueue::Retire(HazardRecord *record, Node *node)
+{
+   record->retired.push_back(node);
+   if (record->retired.size() >= ScanThreshold)
+      Scan(record);
+}
+
+void LockFreeQueue::Scan(HazardRecord *record)
+{
+   vector<void *> hazards;
+   hazards.reserve(MaxRecords * 2);
+   for (HazardRecord &r : records)
+      for (atomic<void *> &h : r.hazard)
+         if (void *p = h.load())
+            hazards.push_back(p);
+   std::sort(hazards.begin(), hazards.end());
+
+   vector<void *> stillHazardous;
+   for (void *p : record->retired)
+   {
+      if (std::binary_search(hazards.begin(), hazards.end(), p))
+         stillHazardous.push_back(p);
+      else
+         delete static_cast<Node *>(p);
+   }
+   record->retired.swap(stillHazardous);
+}
+
+void LockFreeQueue::Enqueue(const Item &item)
+{
+   Node *newTail = new Node(item);
+   HazardRecord *record = AcquireRecord();
+   for (;;)
+   {
+      Node *last = Protect(tail, record, 0);
+      Node *next = last->next.load();
+      if (last != tail.load())
+         continue;
+      if (next)    // tail is lagging; help advance it, then retry
+      {
+         tail.compare_exchange_weak(last, next);
+         continue;
+      }
+      Node *expected = nullptr;
+      if (last->next.compare_exchange_weak(expected, newTail))
+      {
+         tail.compare_exchange_strong(last, newTail);   // failure is fine; others help
+         break;
+      }
+   }
+   ReleaseRecord(record);
+}
+
+optional<Item> LockFreeQueue::Dequeue()
+{
+   HazardRecord *record = AcquireRecord();
+   optional<Item> item;
+   for (;;)
+   {
+      Node *first = Protect(head, record, 0);
+      Node *last = tail.load();
+      Node *next = first->next.load();
+      record->hazard[1].store(next);
+      if (first != head.load())
+         continue;
+      if (!next)
+         break;    // empty
+      if (first == last)   // tail is lagging behind a completed enqueue
+      {
+         tail.compare_exchange_weak(last, next);
+         continue;
+      }
+      if (head.compare_exchange_weak(first, next))
+      {
+         // next is now the dummy; only this thread reads its data
+         item = std::move(next->data);
+         record->hazard[0].store(nullptr);
+         Retire(record, first);
+         break;
+      }
+   }
+   ReleaseRecord(record);
+   return item;
+}
+
+int LockFreeQueue::IsEmpty()
+{
+   HazardRecord *record = AcquireRecord();
+   Node *first = Protect(head, record, 0);
+   int empty = first->next.load() == nullptr;
+   ReleaseRecord(record);
+   return empty;
+}
+
+// A trimmed copy of the LinkList-backed Queue from Chp6-Ex4.cpp, guarded by a mutex,
+// kept here only for comparison
+class LinkListElement
+{
+private:
+   void *data = nullptr;
+   LinkListElement *next = nullptr;
+public:
+   LinkListElement(Item *i) : data(i), next(nullptr) { }
+   ~LinkListElement() { delete static_cast<Item *>(data); next = nullptr; }
+   void *GetData() { return data; }
+   LinkListElement *GetNext() const { return next; }
+   void SetNext(LinkListElement *e) { next = e; }
+};
+
+class LinkList
+{
+private:
+   LinkListElement *head = nullptr;
+   LinkListElement *tail = nullptr;
+public:
+   LinkList() = default;
+   LinkList(const LinkList &) = delete;
+   LinkList &operator=(const LinkList &) = delete;
+   ~LinkList() { while (!IsEmpty()) delete RemoveAtFront(); }
+   void InsertAtEnd(Item *);
+   LinkListElement *RemoveAtFront();
+   int IsEmpty() const { return head == nullptr; }
+};
+
+void LinkList::InsertAtEnd(Item *item)
+{
+   LinkListElement *toAdd = new LinkListElement(item);
+   if (!head)
+      head = tail = toAdd;
+   else
+   {
+      tail->SetNext(toAdd);
+      tail = toAdd;
+   }
+}
+
+LinkListElement *LinkList::RemoveAtFront()
+{
+   LinkListElement *remove = head;
+   head = head->GetNext();
+   if (!head)
+      tail = nullptr;
+   return remove;
+}
+
+class MutexQueue : protected LinkList
+{
+private:
+   std::mutex lock;
+public:
+   void Enqueue(Item *i) { std::lock_guard<std::mutex> guard(lock); InsertAtEnd(i); }
+   Item *Dequeue();    // returns nullptr if empty
+};
+
+Item *MutexQueue::Dequeue()
+{
+   LinkListElement *front;
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      if (LinkList::IsEmpty())
+         return nullptr;
+      front = RemoveAtFront();
+   }
+   Item *item = new Item(*(static_cast<Item *>(front->GetData()))); // make copy of front's data
+   delete front;
+   return item;
+}
+
+// Run 'pairs' producers and 'pairs' consumers moving 'total' items; return items/second
+template <class EnqueueFn, class DequeueFn>
+double RunPairs(int pairs, int total, EnqueueFn enqueue, DequeueFn dequeue)
+{
+   atomic<int> consumed{0};
+   atomic<long long> checksum{0};
+   vector<std::thread> threads;
+   int perProducer = total / pairs;
+   auto start = std::chrono::steady_clock::now();
+   for (int p = 0; p < pairs; p++)
+   {
+      threads.emplace_back([=] { for (int i = 1; i <= perProducer; i++) enqueue(i); });
+      threads.emplace_back([&] {
+         long long sum = 0;
+         while (consumed.load(std::memory_order_relaxed) < perProducer * pairs)
+         {
+            if (optional<Item> item = dequeue())
+            {
+               sum += *item;
+               consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+         }
+         checksum += sum;
+      });
+   }
+   for (std::thread &t : threads)
+      t.join();
+   double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   long long expected = static_cast<long long>(perProducer) * (perProducer + 1) / 2 * pairs;
+   if (checksum.load() != expected)
+      cout << "   (checksum mismatch!)" << endl;
+   return perProducer * pairs / seconds;
+}
+
+int main()
+{
+   LockFreeQueue q1;
+
+   q1.Enqueue(50);
+   q1.Enqueue(67);
+   q1.Enqueue(80);
+   while (!(q1.IsEmpty()))
+      cout << "Dequeued " << *q1.Dequeue() << endl;
+   cout << "Dequeue on an empty queue has value? " << q1.Dequeue().has_value() << endl;
+
+   const int total = 400000;
+   int maxPairs = std::max(4u, std::thread::hardware_concurrency());
+   cout << "Items/second moved through each queue by N producer + N consumer threads:" << endl;
+   for (int pairs = 1; pairs <= maxPairs; pairs *= 2)
+   {
+      LockFreeQueue lockFree;
+      MutexQueue locked;
+      double lockFreeRate = RunPairs(pairs, total,
+         [&](Item i) { lockFree.Enqueue(i); },
+         [&]() { return lockFree.Dequeue(); });
+      double lockedRate = RunPairs(pairs, total,
+         [&](Item i) { locked.Enqueue(new Item(i)); },
+         [&]() -> optional<Item> {
+            Item *item = locked.Dequeue();
+            if (!item)
+               return std::nullopt;
+            Item value = *item;
+            delete item;
+            return value;
+         });
+      cout << "   N = " << pairs << ": lock-free " << lockFreeRate
+           << ", mutex-guarded LinkList " << lockedRate << endl;
+   }
+
+   return 0;
+}
@@ -0,0 +1,287 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose:  To illustrate a lock-free (Treiber) Stack offering the Push/Pop/IsEmpty
+//           interface of the Stack in Chp6-Ex3.cpp. Nodes are addressed by 32-bit index
+//           and each list head carries a 32-bit version tag, which guards against the
+//           ABA problem. Popped nodes are recycled through a second lock-free list rather
+//           than deleted, so Pop returns its Item by value without any heap traffic.
+//           A contention benchmark compares it with a mutex-guarded copy of Stack.
+//           Capacity: at most Capacity (4M) items may be on the stack at once, since nodes
+//           come from a fixed table of chunks; Push returns 0 (and pushes nothing) when full.
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::optional;
+
+typedef int Item;
+
+class LockFreeStack
+{
+private:
+   struct Node
+   {
+      Item data{};
+      atomic<uint32_t> next{0};   // index + 1 of the next node; 0 marks the end
+   };
+   static constexpr uint32_t ChunkSize = 4096;
+   static constexpr uint32_t MaxChunks = 1024;    // room for 4M nodes in use at once
+public:
+   static constexpr uint32_t Capacity = ChunkSize * MaxChunks;
+private:
+   // A list head packs (version tag << 32) | (index + 1) into one 64-bit word, so a
+   // single compare_exchange detects both a changed top and a recycled one
+   atomic<uint64_t> top{0};
+   atomic<uint64_t> freeList{0};
+   atomic<uint32_t> nextFresh{0};               // next never-used node index
+   atomic<Node *> chunks[MaxChunks] = {};       // nodes are never freed until ~LockFreeStack
+
+   Node &NodeAt(uint32_t link) { return chunks[(link - 1) / ChunkSize].load(std::memory_order_acquire)[(link - 1) % ChunkSize]; }
+   uint32_t NewNode();
+   uint32_t PopLink(atomic<uint64_t> &);
+   void PushLink(atomic<uint64_t> &, uint32_t);
+public:
+   LockFreeStack() = default;
+   LockFreeStack(const LockFreeStack &) = delete;
+   LockFreeStack &operator=(const LockFreeStack &) = delete;
+   ~LockFreeStack();
+   int Push(const Item &);     // returns 0 if the stack is full (Capacity items)
+   optional<Item> Pop();
+   int IsEmpty() const { return static_cast<uint32_t>(top.load()) == 0; }
+};
+
+LockFreeStack::~LockFreeStack()
+{
+   for (atomic<Node *> &chunk : chunks)
+      delete [] chunk.load();
+}
+
+// Take a node which has never been used, installing its chunk if necessary; returns 0 once
+// all Capacity nodes have been handed out (nextFresh stops there, so it can never wrap to 0)
+uint32_t LockFreeStack::NewNode()
+{
+   uint32_t index = nextFresh.load(std::memory_order_relaxed);
+   do
+   {
+      if (index >= Capacity)
+         return 0;
+   } while (!nextFresh.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+   atomic<Node *> &chunk = chunks[index / ChunkSize];
+   if (!chunk.load(std::memory_order_acquire))
+   {
+      Node *fresh = new Node[ChunkSize];
+      Node *expected = nullptr;
+      if (!chunk.compare_exchange_strong(expected, fresh))
+         delete [] fresh;    // another thread installed this chunk first
+   }
+   return index + 1;
+}
+
+uint32_t LockFreeStack::PopLink(atomic<uint64_t> &list)
+{
+   uint64_t old = list.load(std::memory_order_acquire);
+   for (;;)
+   {
+      uint32_t link = static_cast<uint32_t>(old);
+      if (link == 0)
+         return 0;
+      // Node memory is never released, so reading next is safe even if another
+      // thread has popped (and reused) this node meanwhile; the tag then differs
+      uint64_t tag = (old >> 32) + 1;
+      uint64_t replacement = (tag << 32) | NodeAt(link).next.load(std::memory_order_relaxed);
+      if (list.compare_exchange_weak(old, replacement, std::memory_order_acquire))
+         return link;
+   }
+}
+
+void LockFreeStack::PushLink(atomic<uint64_t> &list, uint32_t link)
+{
+   uint64_t old = list.load(std::memory_order_relaxed);
+   for (;;)
+   {
+      NodeAt(link).next.store(static_cast<uint32_t>(old), std::memory_order_relaxed);
+      uint64_t tag = (old >> 32) + 1;
+      if (list.compare_exchange_weak(old, (tag << 32) | link, std::memory_order_release))
+         return;
+   }
+}
+
+int LockFreeStack::Push(const Item &item)
+{
+   uint32_t link = PopLink(freeList);
+   if (!link)
+      link = NewNode();
+   if (!link)
+      return 0;     // every node is in use
+   NodeAt(link).data = item;
+   PushLink(top, link);
+   return 1;
+}
+
+optional<Item> LockFreeStack::Pop()
+{
+   uint32_t link = PopLink(top);
+   if (!link)
+      return std::nullopt;
+   Item item = NodeAt(link).data;
+   PushLink(freeList, link);     // recycle the node; no delete
+   return item;
+}
+
+// A trimmed copy of the LinkList-backed Stack from Chp6-Ex3.cpp, guarded by a mutex,
+// kept here only for comparison. Unlike the original, Pop() deletes the removed element.
+class LinkListElement
+{
+private:
+   void *data = nullptr;
+   LinkListElement *next = nullptr;
+public:
+   LinkListElement(Item *i) : data(i), next(nullptr) { }
+   ~LinkListElement() { delete static_cast<Item *>(data); next = nullptr; }
+   void *GetData() { return data; }
+   LinkListElement *GetNext() const { return next; }
+   void SetNext(LinkListElement *e) { next = e; }
+};
+
+class LinkList
+{
+private:
+   LinkListElement *head = nullptr;
+public:
+   LinkList() = default;
+   LinkList(const LinkList &) = delete;
+   LinkList &operator=(const LinkList &) = delete;
+   ~LinkList() { while (!IsEmpty()) delete RemoveAtFront(); }
+   void InsertAtFront(Item *);
+   LinkListElement *RemoveAtFront();
+   int IsEmpty() const { return head == nullptr; }
+};
+
+void LinkList::InsertAtFront(Item *theItem)
+{
+   LinkListElement *newHead = new LinkListElement(theItem);
+   newHead->SetNext(head);
+   head = newHead;
+}
+
+LinkListElement *LinkList::RemoveAtFront()
+{
+   LinkListElement *remove = head;
+   head = head->GetNext();
+   return remove;
+}
+
+class MutexStack : private LinkList
+{
+private:
+   std::mutex lock;
+public:
+   void Push(Item *i) { std::lock_guard<std::mutex> guard(lock); InsertAtFront(i); }
+   Item *Pop();    // returns nullptr if empty
+};
+
+Item *MutexStack::Pop()
+{
+   LinkListElement *top;
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      if (LinkList::IsEmpty())
+         return nullptr;
+      top = RemoveAtFront();
+   }
+   Item *item = new Item(*(static_cast<Item *>(top->GetData())));  // copy top's data
+   delete top;
+   return item;
+}
+
+// Each of 'threads' threads performs 'rounds' of (push 'burst' items, pop 'burst' items);
+// returns push+pop operations per second
+template <class PushFn, class PopFn>
+double RunContention(int threads, int rounds, PushFn push, PopFn pop)
+{
+   const int burst = 8;
+   atomic<long long> balance{0};
+   std::vector<std::thread> workers;
+   auto start = std::chrono::steady_clock::now();
+   for (int t = 0; t < threads; t++)
+   {
+      workers.emplace_back([&, t] {
+         long long local = 0;
+         for (int r = 0; r < rounds; r++)
+         {
+            for (int i = 0; i < burst; i++)
+            {
+               push(t + i);
+               local += t + i;
+            }
+            for (int i = 0; i < burst; i++)
+            {
+               optional<Item> item = pop();
+               if (item)
+                  local -= *item;
+            }
+         }
+         balance += local;
+      });
+   }
+   for (std::thread &w : workers)
+      w.join();
+   double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   if (balance.load() != 0)
+      cout << "   (balance mismatch!)" << endl;
+   return 2.0 * burst * rounds * threads / seconds;
+}
+
+int main()
+{
+   LockFreeStack stack1;
+
+   stack1.Push(3000);
+   stack1.Push(600);
+   stack1.Push(475);
+   while (!(stack1.IsEmpty()))
+      cout << "Popped " << *stack1.Pop() << endl;
+   cout << "Pop on an empty stack has value? " << stack1.Pop().has_value() << endl;
+
+   LockFreeStack full;
+   uint32_t pushed = 0;
+   while (full.Push(static_cast<Item>(pushed)))
+      pushed++;
+   cout << "Pushed " << pushed << " items before the stack was full; after one Pop, Push succeeds? ";
+   full.Pop();
+   cout << full.Push(0) << endl;
+
+   const int totalRounds = 200000;
+   int maxThreads = std::max(4u, std::thread::hardware_concurrency());
+   cout << "Push+pop operations/second by thread count:" << endl;
+   for (int threads = 1; threads <= maxThreads; threads *= 2)
+   {
+      LockFreeStack lockFree;
+      MutexStack locked;
+      double lockFreeRate = RunContention(threads, totalRounds / threads,
+         [&](Item i) { lockFree.Push(i); },
+         [&]() { return lockFree.Pop(); });
+      double lockedRate = RunContention(threads, totalRounds / threads,
+         [&](Item i) { locked.Push(new Item(i)); },
+         [&]() -> optional<Item> {
+            Item *item = locked.Pop();
+            if (!item)
+               return std::nullopt;
+            Item value = *item;
+            delete item;
+            return value;
+         });
+      cout << "   " << threads << " threads: lock-free " << lockFreeRate
+           << ", mutex-guarded Stack " << lockedRate << endl;
+   }
+
+   return 0;
+}
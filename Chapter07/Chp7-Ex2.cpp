@@ -0,0 +1,286 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate a closed-set, by-value alternative to the Person *people[] array of Chp7-Ex1.cpp.
+// When every kind of Person is known up front (here Person and Student), each may be stored by value in
+// a std::variant, and the variants kept contiguously in a vector. Visiting a variant calls the member
+// function of the type it holds by qualified name (e.g. person.Student::Print()), which is an ordinary,
+// inlinable call rather than a virtual one. Person and Student are exactly those of Chp7-Ex1.cpp.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+using std::cout;    //preferred to: using namespace std;
+using std::endl;
+using std::setprecision;
+using std::string;
+using std::vector;
+
+constexpr int MAX = 5;
+
+class Person
+{
+private: 
+    // data members
+    string firstName;
+    string lastName;
+    char middleInitial;
+    string title;  // Mr., Ms., Mrs., Miss, Dr., etc.
+protected:
+    void ModifyTitle(const string &); 
+public:
+    Person();   // default constructor
+    Person(const string &, const string &, char, const string &);  
+    Person(const Person &);  // copy constructor
+    virtual ~Person();  // virtual destructor
+
+    // inline function definitions
+    const string &GetFirstName() const { return firstName; }  
+    const string &GetLastName() const { return lastName; }    
+    const string &GetTitle() const { return title; } 
+    char GetMiddleInitial() const { return middleInitial; }
+
+    // Virtual functions will not be inlined since their 
+    // method must be determined at run time using v-table.
+    virtual void Print() const;
+    virtual void IsA() const;  
+    virtual void Greeting(const string &) const;
+};
+
+Person::Person() : firstName(""), lastName(""), middleInitial('\0'), title("")
+{
+   // dynamically allocate memory for any pointer data members here
+}
+
+Person::Person(const string &fn, const string &ln, char mi, const string &t) :
+               firstName(fn), lastName(ln), middleInitial(mi), title(t)
+{
+   // dynamically allocate memory for any pointer data members here
+}
+
+Person::Person(const Person &p) :
+               firstName(p.firstName), lastName(p.lastName),
+               middleInitial(p.middleInitial), title(p.title)
+{
+   // deep copy any pointer data members here
+}
+
+Person::~Person()
+{
+   // release memory for any dynamically allocated data members
+}
+
+void Person::ModifyTitle(const string &newTitle)
+{
+   title = newTitle;     // assignment between strings ensures a deep assignment
+}
+
+void Person::Print() const
+{
+    cout << title << " " << firstName << " ";
+    cout << middleInitial << ". " << lastName << endl;
+}
+
+void Person::IsA() const
+{
+    cout << "Person" << endl;
+}
+
+void Person::Greeting(const string &msg) const
+{
+    cout << msg << endl;
+}
+
+class Student : public Person
+{
+private: 
+    // data members
+    float gpa;
+    string currentCourse;
+    const string studentId;  
+public:
+    // member function prototypes
+    Student();  // default constructor
+    Student(const string &, const string &, char, const string &, float, const string &, const string &); 
+    Student(const Student &);  // copy constructor
+    virtual ~Student();  // destructor
+    void EarnPhD();  
+    // inline function definitions
+    float GetGpa() const { return gpa; }
+    const string &GetCurrentCourse() const { return currentCourse; }
+    const string &GetStudentId() const { return studentId; }
+    void SetCurrentCourse(const string &); // prototype only
+  
+    // In the derived class, the keyword virtual is optional, 
+    // but recommended for internal documentation
+    virtual void Print() const final override;  // final indicates this may not be overridden beyond Student
+    virtual void IsA() const override;
+    // note: we choose not to redefine Person::Greeting(const string &) const
+};
+
+inline void Student::SetCurrentCourse(const string &c)
+{
+   currentCourse = c;
+}
+
+Student::Student() : gpa(0.0), currentCourse(""), studentId ("")
+{
+   // note: since studentId is const, if the Student is default constructed, this id will always be empty.
+   // Another approach, would be to generate a unique id always and use this in both constructors
+   // dynamically allocate memory for any pointer data members here
+}
+
+// Alternate constructor member function definition
+Student::Student(const string &fn, const string &ln, char mi, const string &t,
+       float avg, const string &course, const string &id) : Person(fn, ln, mi, t),
+                       gpa(avg), currentCourse(course), studentId(id)
+{
+   // dynamically allocate memory for any pointer data members here
+}
+
+// Copy constructor definition
+Student::Student(const Student &s) : Person(s),
+                 gpa(s.gpa), currentCourse(s.currentCourse), studentId(s.studentId)
+{
+   // deep copy any pointer data members of derived class here
+
+}
+
+// destructor definition
+Student::~Student()
+{
+   // release memory for any dynamically allocated data members
+
+}
+
+void Student::EarnPhD()
+{
+    ModifyTitle("Dr.");  
+}
+
+void Student::Print() const
+{   // need to use access functions as these data members are
+    // defined in Person as private
+    cout << GetTitle() << " " << GetFirstName() << " ";
+    cout << GetMiddleInitial() << ". " << GetLastName();
+    cout << " with id: " << studentId << " GPA: ";
+    cout << setprecision(3) <<  " " << gpa;
+    cout << " Course: " << currentCourse << endl;
+}
+
+void Student::IsA() const
+{
+    cout << "Student" << endl;
+}
+
+// A closed set of the kinds of Person; a PersonVariant holds one of them by value
+using PersonVariant = std::variant<Person, Student>;
+
+// Call IsA() and Print() on whichever alternative p holds. The qualified names bypass the v-table:
+// std::visit has already selected the (one) exact type, so the call can be inlined
+void IsA(const PersonVariant &p)
+{
+    std::visit([](const auto &person) {
+        using Type = std::decay_t<decltype(person)>;
+        person.Type::IsA();
+    }, p);
+}
+
+void Print(const PersonVariant &p)
+{
+    std::visit([](const auto &person) {
+        using Type = std::decay_t<decltype(person)>;
+        person.Type::Print();
+    }, p);
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    vector<PersonVariant> people;   // contiguous; no per-Person heap allocation
+    people.reserve(MAX);
+    people.emplace_back(Person("Juliet", "Martinez", 'M', "Ms."));
+    people.emplace_back(Student("Hana", "Sato", 'U', "Dr.", 3.8,
+                                "C++", "178PSU"));
+    people.emplace_back(Student("Sara", "Kato", 'B', "Dr.", 3.9,
+                                "C++", "272PSU"));
+    people.emplace_back(Person("Giselle", "LeBrun", 'R', "Miss"));
+    people.emplace_back(Person("Linus", "Van Pelt", 'S', "Mr."));
+
+    for (const PersonVariant &p : people)
+    {
+       IsA(p);
+       cout << "  ";
+       Print(p);
+    }
+
+    // The same driver loop over 1M people (a random mix of Persons and Students), through virtual
+    // calls on heap objects versus visits of by-value variants. cout is muted so that the loops
+    // measure dispatch and the calls' own work rather than the terminal. Building and destroying
+    // each array is timed as well.
+    const int count = 1000000;
+    vector<int> isStudent(count);
+    std::mt19937 random(3);
+    for (int &s : isStudent)
+       s = random() % 2;
+
+    auto start = std::chrono::steady_clock::now();
+    Person **heapPeople = new Person *[count];
+    for (int i = 0; i < count; i++)
+       heapPeople[i] = isStudent[i] ? new Student("Hana", "Sato", 'U', "Dr.", 3.8, "C++", "178PSU")
+                                    : new Person("Juliet", "Martinez", 'M', "Ms.");
+    double virtualBuild = MillisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    vector<PersonVariant> valuePeople;
+    valuePeople.reserve(count);
+    for (int i = 0; i < count; i++)
+       if (isStudent[i])
+          valuePeople.emplace_back(std::in_place_type<Student>, "Hana", "Sato", 'U', "Dr.", 3.8, "C++", "178PSU");
+       else
+          valuePeople.emplace_back(std::in_place_type<Person>, "Juliet", "Martinez", 'M', "Ms.");
+    double variantBuild = MillisecondsSince(start);
+
+    cout.setstate(std::ios_base::badbit);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+    {
+       heapPeople[i]->IsA();
+       cout << "  ";
+       heapPeople[i]->Print();
+    }
+    double virtualLoop = MillisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    for (const PersonVariant &p : valuePeople)
+    {
+       IsA(p);
+       cout << "  ";
+       Print(p);
+    }
+    double variantLoop = MillisecondsSince(start);
+    cout.clear();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+       delete heapPeople[i];   // engage virtual dest. sequence
+    delete [] heapPeople;
+    double virtualTeardown = MillisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    vector<PersonVariant>().swap(valuePeople);
+    double variantTeardown = MillisecondsSince(start);
+
+    cout << count << " people (ms):       build   IsA()/Print() loop   teardown" << endl;
+    cout << "   virtual, Person *[]  " << setprecision(4) << std::setw(7) << virtualBuild << std::setw(21)
+         << virtualLoop << std::setw(11) << virtualTeardown << endl;
+    cout << "   by-value variants    " << std::setw(7) << variantBuild << std::setw(21)
+         << variantLoop << std::setw(11) << variantTeardown << endl;
+
+    return 0;
+}
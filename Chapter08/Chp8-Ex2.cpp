@@ -0,0 +1,332 @@
+// (c) Copyright Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate a type-segregated ("poly") collection of LifeForms, as an alternative to the
+// LifeForm *entity[] array of Chp8-Ex1.cpp. Each concrete type (Cat, Person, Student) is stored by
+// value in its own contiguous segment, and iteration proceeds segment by segment: all the Cats, then
+// all the Persons, and so on. Every call within a segment reaches the same function, so dispatch is
+// predictable, and the entities of a segment are adjacent in memory. Order across types is not kept.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using std::cout;     // preferred to:  using namespace std;
+using std::endl;
+using std::setprecision;
+using std::string;
+using std::vector;
+
+const int MAX = 5;
+
+// An abstract class is one which collects common traits of derived classes,
+// yet is does not itself represent a tangible entity, or an object which 
+// should be instantiated.  In order to specify a class to be abstract, it 
+// must contain at least one pure virtual function.  A derived class which
+// does not redefine all pure virtual functions in its base class is also
+// considered an abstract class (and can't be instantiated). 
+
+class LifeForm   // abstract class definition
+{
+private:
+   int lifeExpectancy;
+public:
+   LifeForm() { lifeExpectancy = 0; }
+   LifeForm(int life) { lifeExpectancy = life; }
+   LifeForm(const LifeForm &form) 
+       { lifeExpectancy = form.lifeExpectancy; }
+   virtual ~LifeForm() { }      // virtual destructor
+   int GetLifeExpectancy() const { return lifeExpectancy; }
+   virtual void Print() const = 0;   // pure virtual functions 
+   virtual string IsA() const = 0;   
+   virtual string Speak() const = 0;
+};
+
+class Cat: public LifeForm
+{
+private:
+   int numberLivesLeft;
+   string name;
+public:
+   Cat() : LifeForm(15), numberLivesLeft(9), name("") {  }
+   Cat(int lives) : LifeForm(15), numberLivesLeft(lives), name("") {  }
+   Cat(const string &);
+   virtual ~Cat() { }   // virtual destructor
+   const string &GetName() const { return name; }
+   int GetNumberLivesLeft() const { return numberLivesLeft; }
+   virtual void Print() const override;   // redefine pure virtual functions
+   virtual string IsA() const override { return "Cat"; }
+   virtual string Speak() const override { return "Meow!"; }
+};
+
+Cat::Cat(const string &n) : LifeForm(15), numberLivesLeft(9), name(n)
+{
+}
+
+void Cat::Print() const
+{
+   cout << "\t" << name << " has " << numberLivesLeft; 
+   cout << " lives left" << endl;
+}
+
+class Person : public LifeForm
+{
+private: 
+   // data members
+   string firstName;
+   string lastName;
+   char middleInitial;
+   string title;  // Mr., Ms., Mrs., Miss, Dr., etc.
+protected:
+   void ModifyTitle(const string &);  
+public:
+   Person();   // default constructor
+   Person(const string &, const string &, char, const string &);  
+   Person(const Person &);  // copy constructor
+   virtual ~Person();  // destructor
+   const string &GetFirstName() const { return firstName; }  
+   const string &GetLastName() const { return lastName; }    
+   const string &GetTitle() const { return title; } 
+   char GetMiddleInitial() const { return middleInitial; }
+   virtual void Print() const override;  // redefine pure virtual functions
+   virtual string IsA() const override;   
+   virtual string Speak() const override;
+};
+
+Person::Person() : LifeForm(80), firstName(""), lastName(""), middleInitial('\0'), title("")
+{
+}
+
+Person::Person(const string &fn, const string &ln, char mi, const string &t) : 
+               LifeForm(80), firstName(fn), lastName(ln), middleInitial(mi), title(t)
+{
+}
+
+Person::Person(const Person &p) : LifeForm(p), firstName(p.firstName), lastName(p.lastName), 
+                                               middleInitial(p.middleInitial), title(p.title)
+{
+}
+
+Person::~Person()
+{
+}
+
+void Person::ModifyTitle(const string &newTitle)
+{
+   title = newTitle;
+}
+
+void Person::Print() const
+{
+   cout << "\t" << title << " " << firstName << " ";
+   cout << middleInitial << ". " << lastName << endl;
+}
+
+string Person::IsA() const
+{
+   return "Person";
+}
+
+string Person::Speak() const
+{
+   return "Hello!";
+}   
+
+class Student : public Person
+{
+private: 
+   // data members
+   float gpa;
+   string currentCourse;
+   const string studentId;  
+public:
+   Student();  // default constructor
+   Student(const string &, const string &, char, const string &,
+           float, const string &, const string &); 
+   Student(const Student &);  // copy constructor
+   virtual ~Student();  // destructor
+   void EarnPhD();  
+   float GetGpa() const { return gpa; }
+   const string &GetCurrentCourse() const { return currentCourse; }
+   const string &GetStudentId() const { return studentId; }
+   void SetCurrentCourse(const string &);
+   virtual void Print() const final override; // redefine not all virtual functions (and mark Print as the final override)
+   virtual string IsA() const override;
+};
+
+inline void Student::SetCurrentCourse(const string &c)
+{
+   currentCourse = c;
+}
+
+Student::Student() : gpa(0.0), currentCourse(""), studentId ("")
+{
+   // It would be a better idea to initialize studentId to a random id (since it is const and cannot be later reset)
+}
+
+// Alternate constructor member function definition
+Student::Student(const string &fn, const string &ln, char mi, const string &t,
+                 float avg, const string &course, const string &id) : 
+                 Person(fn, ln, mi, t), gpa(avg), currentCourse(course), studentId(id)
+{
+}
+
+// Copy constructor definition
+Student::Student(const Student &s) : Person(s), gpa(s.gpa), currentCourse(s.currentCourse), studentId(s.studentId)
+{
+}
+   
+// destructor definition
+Student::~Student()
+{
+}
+
+void Student::EarnPhD()
+{
+   ModifyTitle("Dr.");  
+}
+
+void Student::Print() const
+{
+   cout << "\t" << GetTitle() << " " << GetFirstName() << " ";
+   cout << GetMiddleInitial() << ". " << GetLastName();
+   cout << " id: " << studentId << "\n\twith gpa: ";   // tab \t followed by word 'with' (no space purposefully)
+   cout << setprecision(2) <<  " " << gpa << " enrolled in: ";
+   cout << currentCourse << endl;
+}
+
+string Student::IsA() const
+{
+   return "Student";
+}
+
+// Holds entities of exactly the listed Types, each of which must be derived from Base. Adding an
+// entity may relocate others of its type (each segment is a vector), so keep indices, not pointers.
+template <class Base, class... Types>
+class PolyCollection
+{
+private:
+   static_assert((std::is_base_of_v<Base, Types> && ...), "each Type must be derived from Base");
+   std::tuple<vector<Types>...> segments;
+public:
+   template <class Type, class... Args>
+   Type &Emplace(Args &&... args) { return Segment<Type>().emplace_back(std::forward<Args>(args)...); }
+   template <class Type>
+   void Insert(const Type &entity) { Segment<Type>().push_back(entity); }
+
+   // typed access to a single segment, e.g. for (Cat &cat : entities.Segment<Cat>())
+   template <class Type>
+   vector<Type> &Segment() { return std::get<vector<Type>>(segments); }
+   template <class Type>
+   const vector<Type> &Segment() const { return std::get<vector<Type>>(segments); }
+
+   // f is called with each entity as its own (most derived) type, one segment after another;
+   // a generic lambda (auto &) sees the concrete type, a Base & parameter works as well
+   template <class Function>
+   void ForEach(Function f);
+   template <class Function>
+   void ForEach(Function f) const;
+   template <class Type, class Function>
+   void ForEachOf(Function f) { for (Type &entity : Segment<Type>()) f(entity); }
+
+   std::size_t Size() const { return (std::get<vector<Types>>(segments).size() + ...); }
+   void Reserve(std::size_t n) { (std::get<vector<Types>>(segments).reserve(n), ...); }
+};
+
+template <class Base, class... Types>
+template <class Function>
+void PolyCollection<Base, Types...>::ForEach(Function f)
+{
+   std::apply([&f](auto &... segment) {
+      ([&f](auto &entities) { for (auto &entity : entities) f(entity); }(segment), ...);
+   }, segments);
+}
+
+template <class Base, class... Types>
+template <class Function>
+void PolyCollection<Base, Types...>::ForEach(Function f) const
+{
+   std::apply([&f](const auto &... segment) {
+      ([&f](const auto &entities) { for (const auto &entity : entities) f(entity); }(segment), ...);
+   }, segments);
+}
+
+using LifeForms = PolyCollection<LifeForm, Cat, Person, Student>;
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+   LifeForms entities;
+   entities.Emplace<Person>("Joy", "Lin", 'M', "Ms.");
+   entities.Emplace<Student>("Renee", "Alexander", 'Z', "Dr.", 3.95, "C++", "21-MIT");
+   entities.Emplace<Student>("Gabby", "Doone", 'A', "Ms.", 3.95, "C++", "18-GWU");
+   entities.Emplace<Cat>("Katje");
+   entities.Emplace<Person>("Giselle", "LeBrun", 'R', "Miss");
+
+   entities.ForEach([](const LifeForm &entity) {   // grouped by type: Cats, then Persons, then Students
+      cout << entity.Speak();
+      cout << " I am a " << entity.IsA() << endl;
+      entity.Print();
+      cout << "\tHas a life expectancy of: ";
+      cout << entity.GetLifeExpectancy();
+      cout << "\n";
+   });
+
+   entities.ForEachOf<Student>([](Student &s) { s.EarnPhD(); });   // typed iteration over one segment
+   cout << "After every Student earns a PhD:" << endl;
+   for (const Student &s : entities.Segment<Student>())
+      s.Print();
+
+   // 1M entities in random type order: virtual calls through LifeForm *[] (heap objects, interleaved
+   // types) versus the segmented collection. The work avoids I/O so that dispatch and memory access
+   // dominate.
+   const int count = 1000000;
+   std::mt19937 random(5);
+   LifeForm **entity = new LifeForm *[count];
+   LifeForms many;
+   for (int i = 0; i < count; i++)
+   {
+      switch (random() % 3)
+      {
+      case 0:
+         entity[i] = new Cat("Katje");
+         many.Emplace<Cat>("Katje");
+         break;
+      case 1:
+         entity[i] = new Person("Joy", "Lin", 'M', "Ms.");
+         many.Emplace<Person>("Joy", "Lin", 'M', "Ms.");
+         break;
+      default:
+         entity[i] = new Student("Gabby", "Doone", 'A', "Ms.", 3.95, "C++", "18-GWU");
+         many.Emplace<Student>("Gabby", "Doone", 'A', "Ms.", 3.95, "C++", "18-GWU");
+      }
+   }
+
+   long pointerTotal = 0, segmentTotal = 0;
+   auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < count; i++)
+      pointerTotal += entity[i]->Speak().size() + entity[i]->IsA().size() + entity[i]->GetLifeExpectancy();
+   double pointerTime = MillisecondsSince(start);
+   start = std::chrono::steady_clock::now();
+   many.ForEach([&segmentTotal](const LifeForm &e) {
+      segmentTotal += e.Speak().size() + e.IsA().size() + e.GetLifeExpectancy();
+   });
+   double segmentTime = MillisecondsSince(start);
+   cout << "Speak()/IsA()/GetLifeExpectancy() over " << count << " entities: LifeForm *[] "
+        << pointerTime << " ms, segmented collection " << segmentTime << " ms"
+        << (pointerTotal == segmentTotal ? "" : " (totals differ!)") << endl;
+
+   for (int i = 0; i < count; i++)
+      delete entity[i];
+   delete [] entity;
+
+   return 0;
+}
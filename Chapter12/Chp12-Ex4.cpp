@@ -0,0 +1,337 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose:  To illustrate a hash for the Person of Chp12-Ex3.cpp which is consistent with its operator==
+// (equal Persons always hash equally), and its use to remove duplicate Persons from a large roster in
+// O(N) rather than by comparing every pair. The hash is stable -- the same on every run and platform --
+// so it may also be stored or exchanged. Deduplication is spread over threads by partitioning the
+// records by hash: equal records share a partition, so each partition is deduplicated independently.
+// operator== is made const (and tolerant of a null title) so that it can serve a hash table, and
+// title is released with delete [] to match its new [].
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstring> // only here to help demonstrate a deep assignment (by including a pointer data member)
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using std::cout;   // preferred to: using namespace std;
+using std::endl;
+using std::string;
+using std::uint64_t;
+using std::vector;
+
+class Person
+{
+private: 
+   string firstName;
+   string lastName;
+   char middleInitial;
+   char *title;  // Mr., Ms., Mrs., Miss, Dr., etc.
+protected:
+   void ModifyTitle(const string &);  // Make this operation available to derived classes
+public:
+   Person();   // default constructor
+   Person(const string &, const string &, char, const char *);  // alternate constructor
+   Person(const Person &);  // copy constructor
+   virtual ~Person();  // destructor
+
+   // inline function definitions
+   const string &GetFirstName() const { return firstName; }  // firstName returned as const string  
+   const string &GetLastName() const { return lastName; }    // so is lastName (via implicit cast)
+   const char *GetTitle() const { return title; } 
+   char GetMiddleInitial() const { return middleInitial; }
+
+   virtual void Print() const;
+   virtual void IsA() const;   
+
+   // An overloaded assignment operator is not inherited by derived classes, therefore 
+   // it must be defined by each class in the hierarchy.  Neglecting to provide an 
+   // overloaded assignment operator will force the compiler to provide you with the 
+   // default definition for assignment between to objects of the same type--a shallow or
+   // C-like memcpy().  This is dangerous for any class which contains data members which
+   // are pointers.
+   Person &operator=(const Person &);  // overloaded assignment operator prototype
+   bool operator==(const Person &) const;     // overloaded comparison operator prototype
+   Person &operator+(const string &);    // overloaded + prototype
+   friend Person &operator+(const string &, Person &);  // non-member friend function for operator+ 
+};                                                    // so operands can be associative
+
+Person::Person() : firstName(""), lastName(""), middleInitial('\0'), title(nullptr)
+{
+}
+
+Person::Person(const string &fn, const string &ln, char mi, const char *t) :
+               firstName(fn), lastName(ln), middleInitial(mi)
+{
+   title = new char[strlen(t) + 1];
+   strcpy(title, t);
+}
+
+Person::Person(const Person &p) : firstName(p.firstName), lastName(p.lastName),
+                                  middleInitial(p.middleInitial)
+{
+   title = new char[strlen(p.title) + 1];
+   strcpy(title, p.title);
+}
+
+
+Person::~Person()
+{
+   delete [] title;
+}
+
+Person &Person::operator=(const Person &p)
+{
+   // make sure we're not assigning an object to itself
+   if (this != &p)  
+   {
+      // delete any previously dynamically allocated data members here from the destination object
+      // or call ~Person() to release this memory -- unconventional
+      delete [] title;
+
+      // Also, remember to reallocate memory for any data members that are pointers.
+      // copy from source to destination object each data member
+      firstName = p.firstName;
+      lastName = p.lastName;
+      middleInitial = p.middleInitial;
+      title = new char[strlen(p.title) + 1];  // memory allocatinon for ptr member
+      strcpy(title, p.title);
+   }
+   return *this;  // allow for cascaded assignments
+}
+
+bool Person::operator==(const Person &p) const
+{
+   // if the objects are the same object, they are equal
+   if (this == &p)
+      return true;
+   // if the contents of the objects are the same,
+   // we'll say the objects are still equivalent
+   else if ( (!firstName.compare(p.firstName)) &&
+             (!lastName.compare(p.lastName)) &&
+             (title == p.title || (title && p.title && !strcmp(title, p.title))) &&   // (either may be null)
+             (middleInitial == p.middleInitial) )
+      return true;
+   else
+      return false;
+}
+
+Person &Person::operator+(const string &t)
+{
+   ModifyTitle(t);
+   return *this;
+}
+
+// Since operator+ is not a member function of Person, it must
+// be a friend of Person in order to have input parameter p access
+// its protected member ModifyTitle()
+Person &operator+(const string &t, Person &p)
+{
+   p.ModifyTitle(t);
+   return p;
+}
+
+void Person::ModifyTitle(const string &newTitle)
+{
+   delete [] title; // delete existing title - stored as a char * just for this example
+   title = new char[strlen(newTitle.c_str()) + 1];   // get the c string equivalent from the string
+   strcpy(title, newTitle.c_str());
+}
+
+void Person::Print() const
+{
+   if (title)
+      cout << title << " ";
+   if (!firstName.empty())
+      cout << firstName << " ";
+   else
+      cout << "No first name ";  
+   if (middleInitial != '\0')
+      cout << middleInitial << ". ";
+   if (!lastName.empty())
+      cout << lastName << endl;
+   else
+      cout << "No last name" << endl;
+}
+
+void Person::IsA() const
+{
+   cout << "Person" << endl;
+}
+
+// A 64-bit hash of exactly the members operator== compares. Each field contributes its length and
+// then its bytes (read as little-endian words, whatever the host), so "ab" + "c" and "a" + "bc"
+// differ, and every word passes through a full-avalanche mixer.
+class PersonHash
+{
+private:
+   static uint64_t Mix(uint64_t);
+   static uint64_t HashBytes(uint64_t, const char *, size_t);
+public:
+   uint64_t operator()(const Person &) const;
+};
+
+uint64_t PersonHash::Mix(uint64_t x)   // the MurmurHash3 finalizer
+{
+   x ^= x >> 33;
+   x *= 0xff51afd7ed558ccdULL;
+   x ^= x >> 33;
+   x *= 0xc4ceb9fe1a85ec53ULL;
+   x ^= x >> 33;
+   return x;
+}
+
+uint64_t PersonHash::HashBytes(uint64_t h, const char *s, size_t length)
+{
+   h = Mix(h ^ length);
+   for ( ; length >= 8; s += 8, length -= 8)
+   {
+      uint64_t word = 0;
+      for (int i = 7; i >= 0; i--)
+         word = (word << 8) | static_cast<unsigned char>(s[i]);
+      h = Mix(h ^ word) * 31;
+   }
+   uint64_t tail = 0;
+   for (size_t i = length; i > 0; i--)
+      tail = (tail << 8) | static_cast<unsigned char>(s[i - 1]);
+   return Mix(h ^ tail);
+}
+
+uint64_t PersonHash::operator()(const Person &p) const
+{
+   uint64_t h = 0x9e3779b97f4a7c15ULL;
+   h = HashBytes(h, p.GetFirstName().data(), p.GetFirstName().size());
+   h = HashBytes(h, p.GetLastName().data(), p.GetLastName().size());
+   if (p.GetTitle())
+      h = HashBytes(h, p.GetTitle(), strlen(p.GetTitle()));
+   else
+      h = Mix(h ^ 0xffffffffffffffffULL);   // a null title differs from an empty one, as in operator==
+   return Mix(h ^ static_cast<unsigned char>(p.GetMiddleInitial()));
+}
+
+// Returns the indices of the first occurrence of each distinct Person, in roster order.
+// Phase 1: each thread hashes a slice of the roster and files each index under partition (hash % P).
+// Phase 2: each thread takes whole partitions and keeps the first of each group of equal records.
+vector<size_t> Deduplicate(const vector<Person> &roster, int threads)
+{
+   if (threads < 1)
+      threads = 1;
+   const size_t count = roster.size();
+   const size_t partitions = 4 * threads;
+   vector<uint64_t> hashes(count);
+   // buckets[t][p]: indices from thread t's slice falling in partition p (in roster order)
+   vector<vector<vector<size_t>>> buckets(threads, vector<vector<size_t>>(partitions));
+   vector<vector<size_t>> kept(partitions);
+
+   auto hashSlice = [&](int t) {
+      PersonHash hash;
+      for (size_t i = count * t / threads; i < count * (t + 1) / threads; i++)
+      {
+         hashes[i] = hash(roster[i]);
+         buckets[t][hashes[i] % partitions].push_back(i);
+      }
+   };
+   auto dedupPartitions = [&](int t) {
+      auto hashOf = [&](size_t i) { return static_cast<size_t>(hashes[i]); };
+      auto same = [&](size_t a, size_t b) { return hashes[a] == hashes[b] && roster[a] == roster[b]; };
+      for (size_t p = t; p < partitions; p += threads)
+      {
+         std::unordered_set<size_t, decltype(hashOf), decltype(same)> seen(16, hashOf, same);
+         for (int slice = 0; slice < threads; slice++)   // slices in order, so the first occurrence wins
+            for (size_t i : buckets[slice][p])
+               if (seen.insert(i).second)
+                  kept[p].push_back(i);
+      }
+   };
+   for (auto phase : { 0, 1 })
+   {
+      vector<std::thread> workers;
+      for (int t = 1; t < threads; t++)
+         workers.emplace_back([&, t] { phase == 0 ? hashSlice(t) : dedupPartitions(t); });
+      phase == 0 ? hashSlice(0) : dedupPartitions(0);
+      for (std::thread &worker : workers)
+         worker.join();
+   }
+
+   vector<char> isKept(count, 0);   // merge the partitions back into roster order
+   for (const vector<size_t> &partition : kept)
+      for (size_t i : partition)
+         isKept[i] = 1;
+   vector<size_t> unique;
+   for (size_t i = 0; i < count; i++)
+      if (isKept[i])
+         unique.push_back(i);
+   return unique;
+}
+
+// Pairwise operator== baseline: compare each record with every record kept so far -- O(N^2)
+vector<size_t> DeduplicatePairwise(const vector<Person> &roster)
+{
+   vector<size_t> unique;
+   for (size_t i = 0; i < roster.size(); i++)
+   {
+      bool duplicate = false;
+      for (size_t j = 0; j < unique.size() && !duplicate; j++)
+         duplicate = roster[unique[j]] == roster[i];
+      if (!duplicate)
+         unique.push_back(i);
+   }
+   return unique;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// A merged roster: 'count' records drawn at random from 'distinct' people, so most appear repeatedly
+vector<Person> MakeRoster(size_t count, size_t distinct)
+{
+   const char *titles[] = { "Ms.", "Mr.", "Dr.", "Miss" };
+   std::mt19937_64 random(17);
+   vector<Person> roster;
+   roster.reserve(count);
+   for (size_t i = 0; i < count; i++)
+   {
+      size_t who = random() % distinct;
+      roster.emplace_back("First" + std::to_string(who % 50000), "Last" + std::to_string(who / 50000),
+                          static_cast<char>('A' + who % 26), titles[who % 4]);
+   }
+   return roster;
+}
+
+int main()
+{
+   Person p1("Gabby", "Doone", 'A', "Miss");
+   Person p2("Gabby", "Doone", 'A', "Miss");
+   Person p3("Renee", "Alexander", 'Z', "Dr.");
+   Person p4("Gabb", "yDoone", 'A', "Miss");    // the same characters, split differently
+   PersonHash hash;
+   cout << "p1 == p2: " << (p1 == p2) << ", hashes equal: " << (hash(p1) == hash(p2)) << endl;
+   cout << "p1 == p3: " << (p1 == p3) << ", hashes equal: " << (hash(p1) == hash(p3)) << endl;
+   cout << "p1 == p4: " << (p1 == p4) << ", hashes equal: " << (hash(p1) == hash(p4)) << endl;
+   cout << "Stable hash of p3: " << std::hex << hash(p3) << std::dec << endl;
+
+   vector<Person> small = MakeRoster(20000, 8000);
+   auto start = std::chrono::steady_clock::now();
+   size_t pairwiseUnique = DeduplicatePairwise(small).size();
+   double pairwiseTime = MillisecondsSince(start);
+   start = std::chrono::steady_clock::now();
+   size_t hashedUnique = Deduplicate(small, 1).size();
+   double hashedTime = MillisecondsSince(start);
+   cout << small.size() << " records: pairwise " << pairwiseTime << " ms (" << pairwiseUnique << " unique), hashed "
+        << hashedTime << " ms (" << hashedUnique << " unique)" << endl;
+
+   vector<Person> large = MakeRoster(4000000, 1500000);
+   for (int threads = 1; threads <= 4; threads *= 2)
+   {
+      start = std::chrono::steady_clock::now();
+      size_t unique = Deduplicate(large, threads).size();
+      cout << large.size() << " records, " << threads << " thread(s): " << MillisecondsSince(start) << " ms ("
+           << unique << " unique)" << endl;
+   }
+
+   return 0;
+}
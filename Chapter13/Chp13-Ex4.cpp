@@ -0,0 +1,190 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate a template LinkList which stores each Type by value inside its
+//          LinkListElement, rather than storing a Type * as in Chp13-Ex3.cpp.
+//          Items are constructed in place (EmplaceAtFront) and removal moves the value
+//          out to the caller, so each element costs one allocation instead of two.
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <utility>
+using std::cout;    // preferred to: using namespace std;
+using std::endl;
+using std::string;
+
+template <class Type> class LinkList;  // forward declaration
+                                     // with template preamble
+template <class Type>   // template preamble for class def
+class LinkListElement
+{
+private:
+   Type data;    // the item itself lives in the element -- no separate allocation
+   LinkListElement *next = nullptr;
+   // private access methods to be used in scope of friend
+   Type &GetData() { return data; }
+   LinkListElement *GetNext() { return next; }
+   void SetNext(LinkListElement *e) { next = e; }
+public:
+   friend class LinkList<Type>;
+   // forward any constructor arguments on to Type's constructor
+   template <class... Args>
+   explicit LinkListElement(Args&&... args) : data(std::forward<Args>(args)...) { }
+   ~LinkListElement() { next = nullptr; }   // data is destroyed as a member
+};
+
+// LinkList should only be extended as a protected or private base class; it does not contain a virtual destructor.
+// It can be used as-is, or as implementation for another ADT.
+
+template <class Type>
+class LinkList
+{
+private:
+   LinkListElement<Type> *head = nullptr;
+   LinkListElement<Type> *tail = nullptr;
+   LinkListElement<Type> *current = nullptr;
+public:
+   LinkList() = default;
+   LinkList(const LinkList &) = delete;             // keep the example focused;
+   LinkList &operator=(const LinkList &) = delete;  // disallow copies and assignment
+   template <class... Args>
+   Type &EmplaceAtFront(Args&&...);
+   void InsertAtFront(const Type &item) { EmplaceAtFront(item); }
+   void InsertAtFront(Type &&item) { EmplaceAtFront(std::move(item)); }
+   Type RemoveAtFront();        // moves the front value out; the element is freed
+   void DeleteAtFront();
+   const Type &Front() const { return head->data; }
+   int IsEmpty() const { return head == nullptr; }
+   void Print();
+   ~LinkList() { while (!IsEmpty()) DeleteAtFront(); }
+};
+
+template <class Type>
+template <class... Args>
+Type &LinkList<Type>::EmplaceAtFront(Args&&... args)
+{
+   LinkListElement<Type> *temp;
+   temp = new LinkListElement<Type>(std::forward<Args>(args)...);
+   temp->SetNext(head);  // temp->next = head;
+   head = temp;
+   if (!tail)
+      tail = head;
+   return temp->GetData();
+}
+
+template <class Type>
+Type LinkList<Type>::RemoveAtFront()
+{
+   LinkListElement<Type> *remove = head;
+   head = head->GetNext();  // head = head->next;
+   if (!head)
+      tail = nullptr;
+   current = head;    // reset current for usage elsewhere
+   Type item(std::move(remove->GetData()));   // move, rather than copy, the value out
+   delete remove;
+   return item;
+}
+
+template <class Type>
+void LinkList<Type>::DeleteAtFront()
+{
+   LinkListElement<Type> *remove = head;
+   head = head->GetNext();
+   if (!head)
+      tail = nullptr;
+   current = head;
+   delete remove;     // no need to move a value nobody wants
+}
+
+template <class Type>
+void LinkList<Type>::Print()
+{
+   if (!head)
+      cout << "<EMPTY>" << endl;
+   current = head;
+   while (current)
+   {
+      cout << current->GetData() << " ";   // data is in the node; no extra pointer chase
+      current = current->GetNext();
+   }
+   cout << endl;
+}
+
+// A minimal copy of the pointer-storing list from Chp13-Ex3.cpp, kept here only
+// so that the two representations may be timed against one another.
+template <class Type>
+class PtrLinkList
+{
+private:
+   struct Element { Type *data; Element *next; };
+   Element *head = nullptr;
+public:
+   PtrLinkList() = default;
+   PtrLinkList(const PtrLinkList &) = delete;
+   PtrLinkList &operator=(const PtrLinkList &) = delete;
+   void InsertAtFront(Type *item) { head = new Element{item, head}; }
+   void DeleteAtFront() { Element *e = head; head = head->next; delete e->data; delete e; }
+   int IsEmpty() const { return head == nullptr; }
+   long long Sum() const { long long s = 0; for (Element *e = head; e; e = e->next) s += *(e->data); return s; }
+   ~PtrLinkList() { while (!IsEmpty()) DeleteAtFront(); }
+};
+
+template <class Type>
+long long SumByValue(LinkList<Type> &list)
+{
+   long long s = 0;
+   while (!list.IsEmpty())
+      s += list.RemoveAtFront();
+   return s;
+}
+
+int main()
+{
+    LinkList<int> list1; // create a LinkList of ints -- no new int() needed
+    list1.EmplaceAtFront(3000);
+    list1.EmplaceAtFront(600);
+    list1.InsertAtFront(475);
+    cout << "List 1: ";
+    list1.Print();
+    // remove elements from list, one by one, receiving each value
+    while (!(list1.IsEmpty()))
+    {
+       int value = list1.RemoveAtFront();
+       cout << "Removed " << value << "; List 1 now: ";
+       list1.Print();
+    }
+
+    LinkList<string> list2;  // a LinkList of strings, built in place
+    list2.EmplaceAtFront("C++");
+    list2.EmplaceAtFront(3, '*');   // string(3, '*')
+    list2.InsertAtFront(string("Templates"));
+    cout << "List 2: ";
+    list2.Print();
+    string moved = list2.RemoveAtFront();   // string's buffer is moved, not copied
+    cout << "Moved out: " << moved << endl;
+
+    const int count = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    long long ptrSum;
+    {
+       PtrLinkList<int> ptrList;
+       for (int i = 0; i < count; i++)
+          ptrList.InsertAtFront(new int(i));   // two allocations per item
+       ptrSum = ptrList.Sum();
+    }
+    auto middle = std::chrono::steady_clock::now();
+    long long valueSum;
+    {
+       LinkList<int> valueList;
+       for (int i = 0; i < count; i++)
+          valueList.EmplaceAtFront(i);         // one allocation per item
+       valueSum = SumByValue(valueList);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    cout << count << " ints, build + traverse + teardown" << endl;
+    cout << "   Type * per element: " << std::chrono::duration<double, std::milli>(middle - start).count()
+         << " ms (sum " << ptrSum << ")" << endl;
+    cout << "   Type by value:      " << std::chrono::duration<double, std::milli>(stop - middle).count()
+         << " ms (sum " << valueSum << ")" << endl;
+
+    return 0;
+}
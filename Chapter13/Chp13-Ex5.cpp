@@ -0,0 +1,349 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate Sort, Merge and Splice operations on the template LinkList of
+//          Chp13-Ex3.cpp. Each operation relinks the existing LinkListElements; none
+//          allocates. Sort is a bottom-up (iterative) merge sort: O(n log n) time, a
+//          fixed array of 64 pointers for extra space, and stable. A LinkList<Item>
+//          (with Item an int) stands in for the void * LinkList of Chapter 6, which
+//          holds exactly the same data.
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+using std::cout;    // preferred to: using namespace std;
+using std::endl;
+using std::vector;
+
+typedef int Item;
+
+template <class Type> class LinkList;  // forward declaration
+                                     // with template preamble
+template <class Type>   // template preamble for class def
+class LinkListElement
+{
+private:
+   Type *data;
+   LinkListElement *next;
+   // private access methods to be used in scope of friend
+   Type *GetData() { return data; }
+   LinkListElement *GetNext() { return next; }
+   void SetNext(LinkListElement *e) { next = e; }
+public:
+   friend class LinkList<Type>;
+   LinkListElement() : data(nullptr), next(nullptr) { }
+   LinkListElement(Type *i) : data(i), next(nullptr) { }
+   ~LinkListElement(){ delete data; next = nullptr;}
+};
+
+// LinkList should only be extended as a protected or private base class; it does not contain a virtual destructor.
+// It can be used as-is, or as implementation for another ADT.
+
+template <class Type>
+class LinkList
+{
+private:
+   LinkListElement<Type> *head, *tail, *current;
+   LinkListElement<Type> *ElementBefore(int);
+   template <class Compare>
+   static LinkListElement<Type> *MergeChains(LinkListElement<Type> *, LinkListElement<Type> *,
+                                             Compare &, LinkListElement<Type> **);
+public:
+   LinkList() { head = tail = current = nullptr; }
+   LinkList(const LinkList &) = delete;             // elements are owned; disallow copies
+   LinkList &operator=(const LinkList &) = delete;
+   void InsertAtFront(Type *);
+   void InsertAtEnd(Type *);
+   LinkListElement<Type> *RemoveAtFront();
+   void DeleteAtFront()  { delete RemoveAtFront(); }
+   int IsEmpty() { return head == nullptr; }
+   void Print();
+   ~LinkList() { while (!IsEmpty()) DeleteAtFront(); }
+
+   template <class Compare = std::less<Type>>
+   void Sort(Compare compare = Compare());
+   template <class Compare = std::less<Type>>
+   void Merge(LinkList &, Compare compare = Compare());   // both lists must already be sorted
+   void Splice(int, LinkList &, int, int);   // move a range of another list's elements here
+   void Splice(int position, LinkList &other) { Splice(position, other, 0, -1); }
+   template <class OutputIterator>
+   void CopyItems(OutputIterator);     // copy each item out, front to back
+   template <class InputIterator>
+   void AssignItems(InputIterator);    // overwrite each item in place, front to back
+};
+
+template <class Type>
+void LinkList<Type>::InsertAtFront(Type *theItem)
+{
+   LinkListElement<Type> *temp;
+   temp = new LinkListElement<Type>(theItem);
+   temp->SetNext(head);  // temp->next = head;
+   head = temp;
+   if (!tail)
+      tail = head;
+}
+
+template <class Type>
+void LinkList<Type>::InsertAtEnd(Type *theItem)
+{
+   LinkListElement<Type> *temp = new LinkListElement<Type>(theItem);
+   if (tail)
+      tail->SetNext(temp);
+   else
+      head = temp;
+   tail = temp;
+}
+
+template <class Type>
+LinkListElement<Type> *LinkList<Type>::RemoveAtFront()
+{
+   LinkListElement<Type> *remove = head;
+   head = head->GetNext();  // head = head->next;
+   if (!head)
+      tail = nullptr;
+   current = head;    // reset current for usage elsewhere
+   remove->SetNext(nullptr);
+   return remove;
+}
+
+template <class Type>
+void LinkList<Type>::Print()
+{
+   if (!head)
+      cout << "<EMPTY>";
+   current = head;
+   while (current)
+   {
+      cout << *(current->GetData()) << " ";
+      current = current->GetNext();
+   }
+   cout << endl;
+}
+
+// Return the element preceding the one at 'position' (nullptr for position 0)
+template <class Type>
+LinkListElement<Type> *LinkList<Type>::ElementBefore(int position)
+{
+   LinkListElement<Type> *before = nullptr;
+   for (int i = 0; i < position && (before ? before->GetNext() : head); i++)
+      before = before ? before->GetNext() : head;
+   return before;
+}
+
+// Merge two sorted, nullptr-terminated chains of elements, preferring 'first' on ties
+// (which keeps sorting stable); the last element of the result is returned via 'last'
+template <class Type>
+template <class Compare>
+LinkListElement<Type> *LinkList<Type>::MergeChains(LinkListElement<Type> *first, LinkListElement<Type> *second,
+                                                   Compare &compare, LinkListElement<Type> **last)
+{
+   LinkListElement<Type> dummy;   // a stand-in predecessor for the merged chain's head
+   LinkListElement<Type> *end = &dummy;
+   while (first && second)
+   {
+      if (compare(*(second->GetData()), *(first->GetData())))
+      {
+         end->SetNext(second);
+         second = second->GetNext();
+      }
+      else
+      {
+         end->SetNext(first);
+         first = first->GetNext();
+      }
+      end = end->GetNext();
+   }
+   end->SetNext(first ? first : second);
+   if (last)    // only walk the leftover chain when the caller needs its end
+   {
+      while (end->GetNext())
+         end = end->GetNext();
+      *last = end;
+   }
+   LinkListElement<Type> *merged = dummy.GetNext();
+   dummy.SetNext(nullptr);
+   return merged;
+}
+
+// Elements are detached from the front one at a time. bins[i] holds either nothing or a
+// sorted chain of 2^i elements; like binary addition, each element "carries" upward,
+// merging with full bins as it goes. Recently touched elements are merged while they
+// are still in cache, and the only extra space is the fixed array of bins.
+template <class Type>
+template <class Compare>
+void LinkList<Type>::Sort(Compare compare)
+{
+   LinkListElement<Type> *bins[64] = {};
+   int used = 0;
+   while (head)
+   {
+      LinkListElement<Type> *carry = head;
+      head = head->GetNext();
+      carry->SetNext(nullptr);
+      int i = 0;
+      for ( ; bins[i]; i++)
+      {
+         carry = MergeChains(bins[i], carry, compare, nullptr);   // bins[i] holds earlier items
+         bins[i] = nullptr;
+      }
+      bins[i] = carry;
+      if (i >= used)
+         used = i + 1;
+   }
+   tail = nullptr;
+   for (int i = 0; i < used; i++)
+      if (bins[i])
+         head = MergeChains(bins[i], head, compare, &tail);
+   current = head;
+}
+
+// Interleave other's elements into this list; equal items from this list come first
+template <class Type>
+template <class Compare>
+void LinkList<Type>::Merge(LinkList &other, Compare compare)
+{
+   if (&other == this)
+      return;
+   head = MergeChains(head, other.head, compare, &tail);
+   if (!head)
+      tail = nullptr;
+   current = head;
+   other.head = other.tail = other.current = nullptr;
+}
+
+// Move 'count' elements of 'other', starting at index 'first', so that they precede the
+// element currently at index 'position' of this list. A count of -1 moves every element
+// from 'first' onward; positions past the end mean "at the end".
+template <class Type>
+void LinkList<Type>::Splice(int position, LinkList &other, int first, int count)
+{
+   if (&other == this || !other.head || count == 0)
+      return;
+   LinkListElement<Type> *beforeFirst = other.ElementBefore(first);
+   LinkListElement<Type> *rangeFirst = beforeFirst ? beforeFirst->GetNext() : other.head;
+   if (!rangeFirst)
+      return;
+   LinkListElement<Type> *rangeLast = rangeFirst;
+   for (int i = 1; (count < 0 || i < count) && rangeLast->GetNext(); i++)
+      rangeLast = rangeLast->GetNext();
+
+   // unlink the range from other
+   LinkListElement<Type> *afterLast = rangeLast->GetNext();
+   if (beforeFirst)
+      beforeFirst->SetNext(afterLast);
+   else
+      other.head = afterLast;
+   if (other.tail == rangeLast)
+      other.tail = beforeFirst;
+   other.current = other.head;
+
+   // link the range into this list
+   LinkListElement<Type> *before = ElementBefore(position);
+   LinkListElement<Type> *after = before ? before->GetNext() : head;
+   rangeLast->SetNext(after);
+   if (before)
+      before->SetNext(rangeFirst);
+   else
+      head = rangeFirst;
+   if (!after)
+      tail = rangeLast;
+   current = head;
+}
+
+template <class Type>
+template <class OutputIterator>
+void LinkList<Type>::CopyItems(OutputIterator out)
+{
+   for (current = head; current; current = current->GetNext())
+      *out++ = *(current->GetData());
+   current = head;
+}
+
+template <class Type>
+template <class InputIterator>
+void LinkList<Type>::AssignItems(InputIterator in)
+{
+   for (current = head; current; current = current->GetNext())
+      *(current->GetData()) = *in++;
+   current = head;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    LinkList<int> list1;
+    for (int value : {3000, 600, 475, 12, 900})
+       list1.InsertAtEnd(new int(value));
+    list1.Sort();
+    cout << "List 1 sorted: ";
+    list1.Print();
+
+    LinkList<int> list2;
+    for (int value : {5, 500, 5000})
+       list2.InsertAtEnd(new int(value));
+    list1.Merge(list2);
+    cout << "List 1 merged with List 2: ";
+    list1.Print();
+    cout << "List 2 after merge: ";
+    list2.Print();
+
+    list2.Splice(0, list1, 2, 3);   // move elements 2..4 of List 1 to the front of List 2
+    cout << "List 1 after splice: ";
+    list1.Print();
+    cout << "List 2 after splice: ";
+    list2.Print();
+
+    LinkList<float> list3;
+    list3.InsertAtEnd(new float(30.50));
+    list3.InsertAtEnd(new float(60.89));
+    list3.InsertAtEnd(new float(45.93));
+    list3.Sort(std::greater<float>());   // any comparator may be supplied
+    cout << "List 3 sorted descending: ";
+    list3.Print();
+
+    const int count = 1000000;
+    std::mt19937 random(7);
+    vector<Item> values(count);
+    for (Item &v : values)
+       v = static_cast<Item>(random() % 1000000);
+
+    // the copy/sort/assign-back baseline: copy the items out of the list into a vector, sort that, and
+    // assign the sorted items back into the list's existing elements
+    LinkList<Item> viaVector;
+    for (Item v : values)
+       viaVector.InsertAtEnd(new Item(v));
+    auto start = std::chrono::steady_clock::now();
+    vector<Item> copy;
+    copy.reserve(count);
+    viaVector.CopyItems(std::back_inserter(copy));
+    std::sort(copy.begin(), copy.end());
+    viaVector.AssignItems(copy.begin());
+    double vectorTime = MillisecondsSince(start);
+
+    LinkList<Item> inPlace;
+    for (Item v : values)
+       inPlace.InsertAtEnd(new Item(v));
+    start = std::chrono::steady_clock::now();
+    inPlace.Sort();
+    double sortTime = MillisecondsSince(start);
+
+    // Both leave the same list in the same order:
+    vector<Item> sortedViaVector, sortedInPlace;
+    viaVector.CopyItems(std::back_inserter(sortedViaVector));
+    inPlace.CopyItems(std::back_inserter(sortedInPlace));
+    if (sortedViaVector != sortedInPlace)
+       cout << "The two sorts disagree!" << endl;
+
+    // The in-place sort trades some speed (each comparison follows pointers to scattered
+    // elements and items) for needing no second copy of the items
+    cout << "Sorting " << count << " nodes: copy out/sort/assign back " << vectorTime << " ms ("
+         << count << "-item vector), in-place merge sort " << sortTime << " ms (no extra storage)" << endl;
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate a persistent (immutable) template list as an alternative to the
+//          LinkList of Chp13-Ex3.cpp when readers need a stable view while writers keep
+//          changing the list. Operations never modify a list; InsertAtFront and
+//          RemoveAtFront return a new version in O(1) which shares every remaining
+//          element with the old version. Elements are reference counted, so taking a
+//          snapshot is just copying a pointer and bumping a count.
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <utility>
+using std::cout;    // preferred to: using namespace std;
+using std::endl;
+
+template <class Type> class PersistentList;  // forward declaration
+
+template <class Type>
+class PersistentListElement
+{
+private:
+   const Type data;
+   const PersistentListElement *const next;   // never changes once the element exists
+   mutable std::atomic<long> refCount{1};     // versions (or elements) referring to this one
+public:
+   friend class PersistentList<Type>;
+   PersistentListElement(Type d, const PersistentListElement *n) : data(std::move(d)), next(n) { }
+};
+
+template <class Type>
+class PersistentList
+{
+private:
+   using Element = PersistentListElement<Type>;
+   const Element *head = nullptr;
+   long size = 0;
+   PersistentList(const Element *h, long s) : head(h), size(s) { }   // adopts a reference
+   static const Element *Share(const Element *e) { if (e) e->refCount.fetch_add(1, std::memory_order_relaxed); return e; }
+   static void Release(const Element *);
+public:
+   PersistentList() = default;
+   PersistentList(const PersistentList &l) : head(Share(l.head)), size(l.size) { }   // a snapshot: O(1)
+   PersistentList(PersistentList &&l) noexcept : head(l.head), size(l.size) { l.head = nullptr; l.size = 0; }
+   PersistentList &operator=(PersistentList);
+   ~PersistentList() { Release(head); }
+
+   PersistentList InsertAtFront(Type) const;
+   PersistentList RemoveAtFront() const;
+   const Type &Front() const { return head->data; }
+   int IsEmpty() const { return head == nullptr; }
+   long Size() const { return size; }
+   template <class Function>
+   void ForEach(Function) const;
+   void Print() const;
+};
+
+// Drop one reference; free each element whose last reference this was. Written as a
+// loop (rather than letting each element release its successor) so that freeing a
+// list of millions of elements cannot overflow the stack.
+template <class Type>
+void PersistentList<Type>::Release(const Element *element)
+{
+   while (element && element->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+   {
+      const Element *next = element->next;
+      delete element;
+      element = next;
+   }
+}
+
+template <class Type>
+PersistentList<Type> &PersistentList<Type>::operator=(PersistentList l)   // copy-and-swap
+{
+   std::swap(head, l.head);
+   std::swap(size, l.size);
+   return *this;
+}
+
+template <class Type>
+PersistentList<Type> PersistentList<Type>::InsertAtFront(Type item) const
+{
+   // the new element takes its own reference to the (shared) remainder of the list
+   return PersistentList(new Element(std::move(item), Share(head)), size + 1);
+}
+
+template <class Type>
+PersistentList<Type> PersistentList<Type>::RemoveAtFront() const
+{
+   return PersistentList(Share(head->next), size - 1);
+}
+
+template <class Type>
+template <class Function>
+void PersistentList<Type>::ForEach(Function f) const
+{
+   for (const Element *e = head; e; e = e->next)
+      f(e->data);
+}
+
+template <class Type>
+void PersistentList<Type>::Print() const
+{
+   if (!head)
+      cout << "<EMPTY>";
+   ForEach([](const Type &item) { cout << item << " "; });
+   cout << endl;
+}
+
+// The pointer-storing LinkList of Chp13-Ex3.cpp, reduced to what a deep-copy snapshot needs, for comparison
+template <class Type>
+class LinkList
+{
+private:
+   struct Element { Type *data; Element *next; };
+   Element *head = nullptr;
+   Element *tail = nullptr;
+public:
+   LinkList() = default;
+   LinkList(const LinkList &);
+   LinkList &operator=(const LinkList &) = delete;
+   ~LinkList();
+   void InsertAtFront(Type *item) { head = new Element{item, head}; if (!tail) tail = head; }
+   void InsertAtEnd(Type *);
+};
+
+template <class Type>
+LinkList<Type>::LinkList(const LinkList &l)   // deep copy: two allocations per element
+{
+   for (Element *e = l.head; e; e = e->next)
+      InsertAtEnd(new Type(*(e->data)));
+}
+
+template <class Type>
+void LinkList<Type>::InsertAtEnd(Type *item)
+{
+   Element *e = new Element{item, nullptr};
+   if (tail)
+      tail->next = e;
+   else
+      head = e;
+   tail = e;
+}
+
+template <class Type>
+LinkList<Type>::~LinkList()
+{
+   while (head)
+   {
+      Element *e = head;
+      head = head->next;
+      delete e->data;
+      delete e;
+   }
+}
+
+int main()
+{
+    PersistentList<int> v0;
+    PersistentList<int> v1 = v0.InsertAtFront(3000);
+    PersistentList<int> v2 = v1.InsertAtFront(600);
+    PersistentList<int> v3 = v2.InsertAtFront(475);
+    PersistentList<int> v4 = v3.RemoveAtFront().RemoveAtFront().InsertAtFront(12);
+    cout << "v0: "; v0.Print();
+    cout << "v1: "; v1.Print();
+    cout << "v2: "; v2.Print();
+    cout << "v3: "; v3.Print();
+    cout << "v4 (shares 3000 with v1..v3): "; v4.Print();
+
+    // A writer publishes new versions while a reader audits snapshots. The mutex guards
+    // only the exchange of the 'latest' version; readers traverse with no lock held.
+    std::mutex publishLock;
+    PersistentList<int> latest;
+    std::atomic<bool> done{false};
+    long audits = 0, inconsistent = 0;
+    std::thread reader([&] {
+       while (!done.load())
+       {
+          PersistentList<int> snapshot;
+          {
+             std::lock_guard<std::mutex> guard(publishLock);
+             snapshot = latest;     // O(1), regardless of the list's length
+          }
+          long count = 0;
+          snapshot.ForEach([&](const int &) { count++; });
+          inconsistent += count != snapshot.Size();   // a snapshot never changes beneath us
+          audits++;
+       }
+    });
+    for (int i = 0; i < 200000; i++)
+    {
+       PersistentList<int> next = (i % 3 == 2) ? latest.RemoveAtFront() : latest.InsertAtFront(i);
+       std::lock_guard<std::mutex> guard(publishLock);
+       latest = std::move(next);
+    }
+    done.store(true);
+    reader.join();
+    cout << "Writer finished with " << latest.Size() << " items; reader took " << audits
+         << " snapshots, " << inconsistent << " inconsistent" << endl;
+
+    const int count = 1000000;
+    LinkList<int> mutableList;
+    PersistentList<int> persistent;
+    for (int i = 0; i < count; i++)
+    {
+       mutableList.InsertAtFront(new int(i));
+       persistent = persistent.InsertAtFront(i);
+    }
+    auto start = std::chrono::steady_clock::now();
+    {
+       LinkList<int> deepCopy(mutableList);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    {
+       PersistentList<int> snapshot(persistent);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    cout << "Snapshot of " << count << " items (take + discard): deep copy "
+         << std::chrono::duration<double, std::milli>(middle - start).count() << " ms, persistent "
+         << std::chrono::duration<double, std::micro>(stop - middle).count() << " us" << endl;
+
+    return 0;
+}
@@ -0,0 +1,505 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate vectorized analytics kernels over a contiguous GPA column, as an
+// alternative to calling Student::GetGpa() one object at a time. The kernels compute
+// count, mean, min, max and variance, a histogram by GPA band, and a count above a
+// threshold. Each kernel has an AVX2 version (chosen at run time when the processor
+// supports it) and a portable scalar fallback; a driver splits the column across threads.
+// The column itself is gathered from Students here; StudentTable::GpaColumn()
+// (Chp14-Ex9.cpp) supplies exactly the same float array.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cmath>
+#include <thread>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define GPA_KERNELS_AVX2 1
+#endif
+
+using std::cout;   // preferred to: using namespace std;
+using std::endl;
+using std::setprecision;
+using std::string;
+using std::vector;
+using std::size_t;
+
+class Person
+{
+private: 
+    string firstName;
+    string lastName;
+    char middleInitial;
+    string title;  // Mr., Ms., Mrs., Miss, Dr., etc.
+protected:
+    void ModifyTitle(const string &); 
+public:
+    Person();   // default constructor
+    Person(const string &, const string &, char, const string &);  
+    Person(const Person &);  // copy constructor
+    Person &operator=(const Person &); // overloaded assignment operator
+    virtual ~Person();  // virtual destructor
+
+    // inline function definitions
+    const string &GetFirstName() const { return firstName; }  
+    const string &GetLastName() const { return lastName; }    
+    const string &GetTitle() const { return title; } 
+    char GetMiddleInitial() const { return middleInitial; }
+
+    // Virtual functions will not be inlined since their 
+    // method must be determined at run time using v-table.
+    virtual void Print() const; 
+    virtual void IsA() const;  
+    virtual void Greeting(const string &) const;
+};
+
+Person::Person() : firstName(""), lastName(""), middleInitial('\0'), title("")
+{
+}
+
+Person::Person(const string &fn, const string &ln, char mi, const string &t) :
+               firstName(fn), lastName(ln), middleInitial(mi), title(t)
+{
+}
+
+Person::Person(const Person &p) : firstName(p.firstName), lastName(p.lastName),
+                                  middleInitial(p.middleInitial), title(p.title)
+{
+}
+
+Person::~Person()
+{
+}
+
+Person &Person::operator=(const Person &p)
+{
+   // make sure we're not assigning an object to itself
+   if (this != &p)
+   {
+      // delete any previously dynamically allocated data members here from the destination object
+      // or call ~Person() to release this memory -- unconventional
+
+      // Also, remember to reallocate memory for any data members that are pointers.
+
+      // copy from source to destination object each data member
+      firstName = p.firstName;
+      lastName = p.lastName;
+      middleInitial = p.middleInitial;
+      title = p.title;
+   }
+   return *this;  // allow for cascaded assignments
+}
+
+void Person::ModifyTitle(const string &newTitle)
+{
+    title = newTitle;
+}
+
+void Person::Print() const
+{
+    cout << title << " " << firstName << " ";
+    cout << middleInitial << ". " << lastName << endl;
+}
+
+void Person::IsA() const
+{
+    cout << "Person" << endl;
+}
+
+void Person::Greeting(const string &msg) const
+{
+    cout << msg << endl;
+}
+
+
+class Student : public Person
+{
+private: 
+    float gpa;
+    string currentCourse;
+    string studentId;      // decided to make studentId not const (a design decision that makes copy constuctor more productive, etc.) 
+    static int numStudents;
+public:
+    // member function prototypes
+    Student();  // default constructor
+    Student(const string &, const string &, char, const string &, float, const string &, const string &); 
+    Student(const Student &);  // copy constructor
+    Student &operator=(const Student &); // overloaded assignment operator
+    virtual ~Student();  // destructor
+    void EarnPhD();  
+    // inline function definitions
+    float GetGpa() const { return gpa; }
+    const string &GetCurrentCourse() const { return currentCourse; }
+    const string &GetStudentId() const { return studentId; }
+    void SetCurrentCourse(const string &); // prototype only
+  
+    // In the derived class, the keyword virtual is optional, 
+    // but recommended for internal documentation. Same for override.
+    virtual void Print() const override;
+    virtual void IsA() const override;
+    // note: we choose not to redefine Person::Greeting(const string &); const
+    static int GetNumberStudents() { return numStudents; }
+};
+
+
+int Student::numStudents = 0;  // definition of static data member
+
+
+inline void Student::SetCurrentCourse(const string &c)
+{
+    currentCourse = c;
+}
+
+Student::Student() : gpa(0.0), currentCourse(""), studentId ("None")
+{
+    numStudents++;
+}
+
+Student::Student(const string &fn, const string &ln, char mi, const string &t, float avg, const string &course,
+                 const string &id) : Person(fn, ln, mi, t), gpa(avg), currentCourse(course), studentId(id)
+{
+    numStudents++;
+}
+
+Student::Student(const Student &s) : Person(s), gpa(s.gpa), currentCourse(s.currentCourse), studentId(s.studentId)
+{
+    numStudents++;
+}
+
+// destructor definition
+Student::~Student()
+{
+    numStudents--;
+    // the embedded object studentId will also be destructed
+}
+
+// overloaded assignment operator
+Student &Student::operator=(const Student &s)
+{
+   // make sure we're not assigning an object to itself
+   if (this != &s)
+   {
+      Person::operator=(s);
+
+      // delete any dynamically allocated data members in destination Student (or call ~Student() - unconventional)
+
+      // remember to allocate any memory in destination for copies of source members
+
+      // copy data members from source to desination object
+      gpa = s.gpa;
+      currentCourse = s.currentCourse;
+      studentId = s.studentId;
+
+   }
+   return *this;  // allow for cascaded assignments
+}
+
+void Student::EarnPhD()
+{
+    ModifyTitle("Dr.");
+}
+
+void Student::Print() const
+{   // need to use access functions as these data members are
+    // defined in Person as private
+    cout << GetTitle() << " " << GetFirstName() << " ";
+    cout << GetMiddleInitial() << ". " << GetLastName();
+    cout << " with id: " << studentId << " GPA: ";
+    cout << setprecision(3) <<  " " << gpa;
+    cout << " Course: " << currentCourse << endl;
+}
+
+void Student::IsA() const
+{
+    cout << "Student" << endl;
+}
+
+
+// Band edges for the histogram: band b holds GPAs in [BandEdges[b], BandEdges[b + 1]),
+// with the last band closed at the top (a 4.0 belongs to band 4)
+constexpr int NumBands = 5;
+constexpr float BandEdges[NumBands + 1] = { 0.0f, 1.0f, 2.0f, 3.0f, 3.5f, 4.0f };
+
+struct GpaSummary
+{
+    size_t count = 0;
+    double sum = 0.0;
+    double sumOfSquares = 0.0;
+    float min = 0.0f;
+    float max = 0.0f;
+    size_t aboveThreshold = 0;
+    size_t bands[NumBands] = {};   // values outside [0.0, 4.0] are not counted in any band
+
+    double Mean() const { return count ? sum / count : 0.0; }
+    double Variance() const { return count ? sumOfSquares / count - Mean() * Mean() : 0.0; }
+    void Combine(const GpaSummary &);
+};
+
+void GpaSummary::Combine(const GpaSummary &other)
+{
+    if (other.count == 0)
+        return;
+    if (count == 0)
+    {
+        *this = other;
+        return;
+    }
+    count += other.count;
+    sum += other.sum;
+    sumOfSquares += other.sumOfSquares;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    aboveThreshold += other.aboveThreshold;
+    for (int b = 0; b < NumBands; b++)
+        bands[b] += other.bands[b];
+}
+
+// Portable kernel: one pass, one value at a time
+GpaSummary SummarizeScalar(const float *gpa, size_t n, float threshold)
+{
+    GpaSummary s;
+    if (n == 0)
+        return s;
+    s.count = n;
+    s.min = s.max = gpa[0];
+    size_t atLeast[NumBands + 1] = {};   // atLeast[e]: values >= BandEdges[e]
+    for (size_t i = 0; i < n; i++)
+    {
+        float g = gpa[i];
+        s.sum += g;
+        s.sumOfSquares += static_cast<double>(g) * g;
+        s.min = std::min(s.min, g);
+        s.max = std::max(s.max, g);
+        s.aboveThreshold += g > threshold;
+        for (int e = 0; e < NumBands; e++)
+            atLeast[e] += g >= BandEdges[e];
+        atLeast[NumBands] += g > BandEdges[NumBands];   // above the top edge
+    }
+    for (int b = 0; b < NumBands; b++)
+        s.bands[b] = atLeast[b] - atLeast[b + 1];
+    return s;
+}
+
+#ifdef GPA_KERNELS_AVX2
+// Add the eight 32-bit lane counts of counter into total, then reset the counter
+__attribute__((target("avx2")))
+void DrainLaneCounts(__m256i &counter, size_t &total)
+{
+    unsigned counts[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(counts), counter);
+    for (int lane = 0; lane < 8; lane++)
+        total += counts[lane];
+    counter = _mm256_setzero_si256();
+}
+
+// AVX2 kernel: eight floats per step. Sums are carried in double precision (four lanes
+// for each half of the eight floats) so that tens of millions of values lose no accuracy.
+// Band counts use the same "at least edge e" trick as the scalar kernel: each comparison
+// yields lanes of all ones (-1 as an integer), which are subtracted from a counter.
+__attribute__((target("avx2")))
+GpaSummary SummarizeAvx2(const float *gpa, size_t n, float threshold)
+{
+    GpaSummary s;
+    if (n < 8)
+        return SummarizeScalar(gpa, n, threshold);
+    __m256d sumLo = _mm256_setzero_pd(), sumHi = _mm256_setzero_pd();
+    __m256d sqLo = _mm256_setzero_pd(), sqHi = _mm256_setzero_pd();
+    __m256 minV = _mm256_loadu_ps(gpa), maxV = minV;
+    __m256 limit = _mm256_set1_ps(threshold);
+    __m256i above = _mm256_setzero_si256();
+    __m256 edges[NumBands + 1];
+    __m256i atLeast[NumBands + 1];
+    for (int e = 0; e <= NumBands; e++)
+    {
+        edges[e] = _mm256_set1_ps(BandEdges[e]);
+        atLeast[e] = _mm256_setzero_si256();
+    }
+
+    // Each 32-bit lane counter gains at most one per step, so the counters are drained
+    // into the size_t totals every 2^28 steps, long before they could wrap
+    const size_t drainSteps = size_t(1) << 28;
+    size_t aboveTotal = 0;
+    size_t ge[NumBands + 1] = {};
+
+    size_t i = 0;
+    while (i + 8 <= n)
+    {
+        size_t blockEnd = i + std::min((n - i) / 8, drainSteps) * 8;
+        for ( ; i < blockEnd; i += 8)
+        {
+            __m256 g = _mm256_loadu_ps(gpa + i);
+            __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(g));
+            __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(g, 1));
+            sumLo = _mm256_add_pd(sumLo, lo);
+            sumHi = _mm256_add_pd(sumHi, hi);
+            sqLo = _mm256_add_pd(sqLo, _mm256_mul_pd(lo, lo));
+            sqHi = _mm256_add_pd(sqHi, _mm256_mul_pd(hi, hi));
+            minV = _mm256_min_ps(minV, g);
+            maxV = _mm256_max_ps(maxV, g);
+            above = _mm256_sub_epi32(above, _mm256_castps_si256(_mm256_cmp_ps(g, limit, _CMP_GT_OQ)));
+            for (int e = 0; e < NumBands; e++)
+                atLeast[e] = _mm256_sub_epi32(atLeast[e], _mm256_castps_si256(_mm256_cmp_ps(g, edges[e], _CMP_GE_OQ)));
+            atLeast[NumBands] = _mm256_sub_epi32(atLeast[NumBands],
+                                                 _mm256_castps_si256(_mm256_cmp_ps(g, edges[NumBands], _CMP_GT_OQ)));
+        }
+        DrainLaneCounts(above, aboveTotal);
+        for (int e = 0; e <= NumBands; e++)
+            DrainLaneCounts(atLeast[e], ge[e]);
+    }
+
+    // reduce the vector lanes into the summary
+    double sums[4], squares[4];
+    _mm256_storeu_pd(sums, _mm256_add_pd(sumLo, sumHi));
+    _mm256_storeu_pd(squares, _mm256_add_pd(sqLo, sqHi));
+    float mins[8], maxs[8];
+    _mm256_storeu_ps(mins, minV);
+    _mm256_storeu_ps(maxs, maxV);
+    s.count = i;
+    s.min = mins[0];
+    s.max = maxs[0];
+    for (int lane = 0; lane < 4; lane++)
+    {
+        s.sum += sums[lane];
+        s.sumOfSquares += squares[lane];
+    }
+    for (int lane = 0; lane < 8; lane++)
+    {
+        s.min = std::min(s.min, mins[lane]);
+        s.max = std::max(s.max, maxs[lane]);
+    }
+    s.aboveThreshold = aboveTotal;
+    for (int b = 0; b < NumBands; b++)
+        s.bands[b] = ge[b] - ge[b + 1];
+
+    s.Combine(SummarizeScalar(gpa + i, n - i, threshold));   // the final few values
+    return s;
+}
+#endif
+
+// Use AVX2 when the processor has it (checked once); otherwise the scalar kernel
+GpaSummary Summarize(const float *gpa, size_t n, float threshold)
+{
+#ifdef GPA_KERNELS_AVX2
+    static const bool haveAvx2 = __builtin_cpu_supports("avx2");
+    if (haveAvx2)
+        return SummarizeAvx2(gpa, n, threshold);
+#endif
+    return SummarizeScalar(gpa, n, threshold);
+}
+
+// Split the column into one contiguous chunk per thread, summarize each, then combine
+GpaSummary SummarizeParallel(const float *gpa, size_t n, float threshold, int threads)
+{
+    size_t chunks = std::max(1, threads);
+    vector<GpaSummary> partial(chunks);
+    vector<std::thread> workers;
+    size_t chunkSize = (n + chunks - 1) / chunks;
+    for (size_t c = 0; c < chunks; c++)
+    {
+        size_t first = std::min(n, c * chunkSize);
+        size_t last = std::min(n, first + chunkSize);
+        workers.emplace_back([=, &partial] { partial[c] = Summarize(gpa + first, last - first, threshold); });
+    }
+    GpaSummary total;
+    for (size_t c = 0; c < chunks; c++)
+    {
+        workers[c].join();
+        total.Combine(partial[c]);
+    }
+    return total;
+}
+
+// Baseline (Chp14-Ex3 style): one Student at a time through GetGpa()
+GpaSummary SummarizeStudents(const vector<Student> &students, float threshold)
+{
+    GpaSummary s;
+    if (students.empty())
+        return s;
+    s.count = students.size();
+    s.min = s.max = students[0].GetGpa();
+    for (const Student &student : students)
+    {
+        float g = student.GetGpa();
+        s.sum += g;
+        s.sumOfSquares += static_cast<double>(g) * g;
+        s.min = std::min(s.min, g);
+        s.max = std::max(s.max, g);
+        s.aboveThreshold += g > threshold;
+        for (int b = 0; b < NumBands; b++)
+            if (g >= BandEdges[b] && (g < BandEdges[b + 1] || (b == NumBands - 1 && g == BandEdges[b + 1])))
+                s.bands[b]++;
+    }
+    return s;
+}
+
+vector<float> GatherGpaColumn(const vector<Student> &students)
+{
+    vector<float> column;
+    column.reserve(students.size());
+    for (const Student &s : students)
+        column.push_back(s.GetGpa());
+    return column;
+}
+
+// Counts, min and max must agree exactly; mean and variance are summed in a different
+// order by each kernel, so they need only agree to within a small relative tolerance
+bool SameSummary(const GpaSummary &a, const GpaSummary &b)
+{
+    auto close = [](double x, double y) { return std::fabs(x - y) <= 1e-9 * std::max(1.0, std::fabs(y)); };
+    if (a.count != b.count || a.min != b.min || a.max != b.max || a.aboveThreshold != b.aboveThreshold)
+        return false;
+    for (int band = 0; band < NumBands; band++)
+        if (a.bands[band] != b.bands[band])
+            return false;
+    return close(a.Mean(), b.Mean()) && close(a.Variance(), b.Variance());
+}
+
+void PrintSummary(const string &label, const GpaSummary &s, double ms, bool matches = true)
+{
+    cout << label << ": " << ms << " ms  (n " << s.count << ", mean " << s.Mean() << ", var "
+         << s.Variance() << ", min " << s.min << ", max " << s.max << ", > 3.5: " << s.aboveThreshold
+         << ", bands";
+    for (int b = 0; b < NumBands; b++)
+        cout << " " << s.bands[b];
+    cout << ")" << (matches ? "" : " (MISMATCH)") << endl;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    const size_t count = 2000000;
+    const float threshold = 3.5f;
+    vector<Student> roster;
+    roster.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        roster.push_back(Student("Jo", "Li", 'H', "Ms.", (i * 7919 % 401) / 100.0f, "C++", "UD1234"));
+    vector<float> gpa = GatherGpaColumn(roster);
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+
+    cout << setprecision(6);
+    auto start = std::chrono::steady_clock::now();
+    GpaSummary naive = SummarizeStudents(roster, threshold);
+    PrintSummary("GetGpa() loop      ", naive, MillisecondsSince(start));
+
+    start = std::chrono::steady_clock::now();
+    GpaSummary scalar = SummarizeScalar(gpa.data(), gpa.size(), threshold);
+    PrintSummary("Scalar column      ", scalar, MillisecondsSince(start), SameSummary(scalar, naive));
+
+    start = std::chrono::steady_clock::now();
+    GpaSummary best = Summarize(gpa.data(), gpa.size(), threshold);
+    PrintSummary("Best kernel column ", best, MillisecondsSince(start), SameSummary(best, naive));
+
+    start = std::chrono::steady_clock::now();
+    GpaSummary parallel = SummarizeParallel(gpa.data(), gpa.size(), threshold, threads);
+    PrintSummary("Parallel x" + std::to_string(threads) + "        ", parallel, MillisecondsSince(start),
+                 SameSummary(parallel, naive));
+
+    return 0;
+}
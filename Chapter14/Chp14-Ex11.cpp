@@ -0,0 +1,428 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate a sorted, contiguous FlatMap as an index for a studentBody, as a companion
+// to the STL map with a functor of Chp14-Ex8.cpp. Keys and values are kept in two vectors in key
+// order, so a lookup is a binary search over adjacent keys rather than a walk through tree nodes.
+// The comparison is transparent (std::less<>), so a string_view can be looked up without making
+// a string. A FlatMap is built in bulk from unsorted pairs (sorted once), and FindBatch() looks up
+// many keys at a time, prefetching each search's next probe while the others are compared.
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using std::cout;   // preferred to: using namespace std;
+using std::endl;
+using std::setprecision;
+using std::string;
+using std::string_view;
+using std::map;
+using std::pair;
+using std::vector;
+
+class Person
+{
+private: 
+    string firstName;
+    string lastName;
+    char middleInitial;
+    string title;  // Mr., Ms., Mrs., Miss, Dr., etc.
+protected:
+    void ModifyTitle(const string &); 
+public:
+    Person();   // default constructor
+    Person(const string &, const string &, char, const string &);  
+    Person(const Person &);  // copy constructor
+    Person &operator=(const Person &); // overloaded assignment operator
+    virtual ~Person();  // virtual destructor
+
+    // inline function definitions
+    const string &GetFirstName() const { return firstName; }  
+    const string &GetLastName() const { return lastName; }    
+    const string &GetTitle() const { return title; } 
+    char GetMiddleInitial() const { return middleInitial; }
+
+    // Virtual functions will not be inlined since their 
+    // method must be determined at run time using v-table.
+    virtual void Print() const; 
+    virtual void IsA() const;  
+    virtual void Greeting(const string &) const;
+};
+
+Person::Person() : firstName(""), lastName(""), middleInitial('\0'), title("")
+{
+}
+
+Person::Person(const string &fn, const string &ln, char mi, const string &t) :
+               firstName(fn), lastName(ln), middleInitial(mi), title(t)
+{
+}
+
+Person::Person(const Person &p) : firstName(p.firstName), lastName(p.lastName),
+                                  middleInitial(p.middleInitial), title(p.title)
+{
+}
+
+Person::~Person()
+{
+}
+
+Person &Person::operator=(const Person &p)
+{
+   // make sure we're not assigning an object to itself
+   if (this != &p)
+   {
+      // delete any previously dynamically allocated data members here from the destination object
+      // or call ~Person() to release this memory -- unconventional
+
+      // Also, remember to reallocate memory for any data members that are pointers.
+
+      // copy from source to destination object each data member
+      firstName = p.firstName;
+      lastName = p.lastName;
+      middleInitial = p.middleInitial;
+      title = p.title;
+   }
+   return *this;  // allow for cascaded assignments
+}
+
+void Person::ModifyTitle(const string &newTitle)
+{
+    title = newTitle;
+}
+
+void Person::Print() const
+{
+    cout << title << " " << firstName << " ";
+    cout << middleInitial << ". " << lastName << endl;
+}
+
+void Person::IsA() const
+{
+    cout << "Person" << endl;
+}
+
+void Person::Greeting(const string &msg) const
+{
+    cout << msg << endl;
+}
+
+
+class Student : public Person
+{
+private: 
+    float gpa;
+    string currentCourse;
+    string studentId;      // decided to make studentId not const (a design decision that makes copy constuctor more productive, etc.) 
+    static int numStudents;
+public:
+    // member function prototypes
+    Student();  // default constructor
+    Student(const string &, const string &, char, const string &, float, const string &, const string &); 
+    Student(const Student &);  // copy constructor
+    Student &operator=(const Student &); // overloaded assignment operator
+    virtual ~Student();  // destructor
+    void EarnPhD();  
+    // inline function definitions
+    float GetGpa() const { return gpa; }
+    const string &GetCurrentCourse() const { return currentCourse; }
+    const string &GetStudentId() const { return studentId; }
+    void SetCurrentCourse(const string &); // prototype only
+  
+    // In the derived class, the keyword virtual is optional, 
+    // but recommended for internal documentation. Same for override.
+    virtual void Print() const override;
+    virtual void IsA() const override;
+    // note: we choose not to redefine Person::Greeting(const string &); const
+    static int GetNumberStudents() { return numStudents; }
+};
+
+
+int Student::numStudents = 0;  // definition of static data member
+
+
+inline void Student::SetCurrentCourse(const string &c)
+{
+    currentCourse = c;
+}
+
+Student::Student() : gpa(0.0), currentCourse(""), studentId ("None")
+{
+    numStudents++;
+}
+
+Student::Student(const string &fn, const string &ln, char mi, const string &t, float avg, const string &course,
+                 const string &id) : Person(fn, ln, mi, t), gpa(avg), currentCourse(course), studentId(id)
+{
+    numStudents++;
+}
+
+Student::Student(const Student &s) : Person(s), gpa(s.gpa), currentCourse(s.currentCourse), studentId(s.studentId)
+{
+    numStudents++;
+}
+
+// destructor definition
+Student::~Student()
+{
+    numStudents--;
+    // the embedded object studentId will also be destructed
+}
+
+// overloaded assignment operator
+Student &Student::operator=(const Student &s)
+{
+   // make sure we're not assigning an object to itself
+   if (this != &s)
+   {
+      Person::operator=(s);
+
+      // delete any dynamically allocated data members in destination Student (or call ~Student() - unconventional)
+
+      // remember to allocate any memory in destination for copies of source members
+
+      // copy data members from source to desination object
+      gpa = s.gpa;
+      currentCourse = s.currentCourse;
+      studentId = s.studentId;
+
+   }
+   return *this;  // allow for cascaded assignments
+}
+
+void Student::EarnPhD()
+{
+    ModifyTitle("Dr.");
+}
+
+void Student::Print() const
+{   // need to use access functions as these data members are
+    // defined in Person as private
+    cout << GetTitle() << " " << GetFirstName() << " ";
+    cout << GetMiddleInitial() << ". " << GetLastName();
+    cout << " with id: " << studentId << " GPA: ";
+    cout << setprecision(3) <<  " " << gpa;
+    cout << " Course: " << currentCourse << endl;
+}
+
+void Student::IsA() const
+{
+    cout << "Student" << endl;
+}
+
+
+// The functor of Chp14-Ex8.cpp (each key is still passed by value), except that it uses > rather
+// than >=. Returning true for equal keys is not a strict weak ordering, so find() could never match.
+struct comparison
+{
+    bool operator() (string key1, string key2) const
+    {
+        int ans = key1.compare(key2);
+        if (ans > 0) 
+            return true;   // return true if greater than
+        else 
+            return false;  // return false if they are equal or less than
+    }
+    comparison() { }
+    ~comparison() { }
+};
+
+// A map kept as two parallel vectors sorted by key (no per-element nodes). Insertion is O(N), so
+// a FlatMap suits an index that is built once and then mostly searched.
+template <class Key, class Value, class Compare = std::less<>>
+class FlatMap
+{
+private:
+    vector<Key> keys;
+    vector<Value> values;
+    Compare compare;
+    template <class K> size_t LowerBound(const K &) const;
+public:
+    FlatMap() = default;
+    explicit FlatMap(vector<pair<Key, Value>> &&);   // bulk build; the first of equal keys is kept
+    size_t Size() const { return keys.size(); }
+    const Key &KeyAt(size_t i) const { return keys[i]; }
+    const Value &ValueAt(size_t i) const { return values[i]; }
+    int Insert(const Key &, const Value &);    // returns 0 if the key was already present
+
+    // K may be any type Compare can order against Key (e.g. string_view for string keys)
+    template <class K> const Value *Find(const K &) const;    // nullptr if not found
+    template <class K> void FindBatch(const vector<K> &, vector<const Value *> &) const;
+};
+
+template <class Key, class Value, class Compare>
+FlatMap<Key, Value, Compare>::FlatMap(vector<pair<Key, Value>> &&unsorted)
+{
+    // sort positions rather than the pairs themselves, so each element is moved only once
+    vector<size_t> order(unsorted.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                     { return compare(unsorted[a].first, unsorted[b].first); });
+    keys.reserve(order.size());
+    values.reserve(order.size());
+    for (size_t i : order)
+    {
+        if (!keys.empty() && !compare(keys.back(), unsorted[i].first))
+            continue;   // an equal key is already present
+        keys.push_back(std::move(unsorted[i].first));
+        values.push_back(std::move(unsorted[i].second));
+    }
+    unsorted.clear();
+}
+
+template <class Key, class Value, class Compare>
+template <class K>
+size_t FlatMap<Key, Value, Compare>::LowerBound(const K &key) const
+{
+    return std::lower_bound(keys.begin(), keys.end(), key, compare) - keys.begin();
+}
+
+template <class Key, class Value, class Compare>
+int FlatMap<Key, Value, Compare>::Insert(const Key &key, const Value &value)
+{
+    size_t i = LowerBound(key);
+    if (i < keys.size() && !compare(key, keys[i]))
+        return 0;
+    keys.insert(keys.begin() + i, key);
+    values.insert(values.begin() + i, value);
+    return 1;
+}
+
+template <class Key, class Value, class Compare>
+template <class K>
+const Value *FlatMap<Key, Value, Compare>::Find(const K &key) const
+{
+    size_t i = LowerBound(key);
+    return (i < keys.size() && !compare(key, keys[i])) ? &values[i] : nullptr;
+}
+
+// Runs the binary searches for a group of queries in lockstep: every search in a group has the
+// same number of steps, so each step can prefetch the keys all of them will probe next, and
+// those cache misses overlap rather than being taken one search at a time
+template <class Key, class Value, class Compare>
+template <class K>
+void FlatMap<Key, Value, Compare>::FindBatch(const vector<K> &queries, vector<const Value *> &results) const
+{
+    constexpr size_t Group = 16;
+    results.assign(queries.size(), nullptr);
+    if (keys.empty())
+        return;
+    const Key *base[Group];
+    for (size_t first = 0; first < queries.size(); first += Group)
+    {
+        size_t count = std::min(Group, queries.size() - first);
+        for (size_t j = 0; j < count; j++)
+            base[j] = keys.data();
+        size_t n = keys.size();
+        while (n > 1)
+        {
+            size_t half = n / 2;
+            size_t nextHalf = (n - half) / 2;   // the next step probes base[j][nextHalf - 1]
+            for (size_t j = 0; j < count; j++)
+            {
+                base[j] = compare(base[j][half - 1], queries[first + j]) ? base[j] + half : base[j];
+#if defined(__GNUC__)
+                if (nextHalf > 0)
+                    __builtin_prefetch(base[j] + nextHalf - 1);
+#endif
+            }
+            n -= half;
+        }
+        for (size_t j = 0; j < count; j++)   // base[j] is now the only candidate
+            if (!compare(*base[j], queries[first + j]) && !compare(queries[first + j], *base[j]))
+                results[first + j] = &values[base[j] - keys.data()];
+    }
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    Student s1("Hana", "Sato", 'U', "Dr.", 3.8, "C++", "178PSU"); 
+    Student s2("Sara", "Kato", 'B', "Dr.", 3.9, "C++", "272PSU"); 
+    Student s3("Jill", "Long", 'R', "Dr.", 3.7, "C++", "234PSU"); 
+
+    // build the index from unsorted pairs, then look up by string_view (no string is made)
+    vector<pair<string, Student>> unsorted { { s1.GetStudentId(), s1 }, { s2.GetStudentId(), s2 },
+                                             { s3.GetStudentId(), s3 } };
+    FlatMap<string, Student> studentBody(std::move(unsorted));
+    for (size_t i = 0; i < studentBody.Size(); i++)
+        cout << studentBody.KeyAt(i) << " " << studentBody.ValueAt(i).GetFirstName() << endl;
+    string_view id = "234PSU";
+    if (const Student *found = studentBody.Find(id))
+        found->Print();
+    if (!studentBody.Find(string_view("999PSU")))
+        cout << "999PSU is not enrolled" << endl;
+
+    // benchmark: build and look up a large studentBody, as a map (Chp14-Ex8.cpp) and as a FlatMap
+    const int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const char *firstNames[] = { "Hana", "Sara", "Jill", "Giselle", "Alexandria" };
+    const char *lastNames[] = { "Sato", "Kato", "Long", "LeBrun", "Featherstonehaugh" };
+    vector<Student> roster;
+    roster.reserve(count);
+    char buffer[16];
+    for (int i = 0; i < count; i++)
+    {
+        std::snprintf(buffer, sizeof(buffer), "%07dPSU", static_cast<int>(i * 7919LL % count));   // ids in no order
+        roster.emplace_back(firstNames[i % 5], lastNames[i / 5 % 5], 'A' + i % 26, "Ms.", 2.0 + i % 200 / 100.0,
+                            "C++", buffer);
+    }
+    vector<string> idText;   // the ids to look up (half enrolled), in random order
+    for (int i = 0; i < count; i++)
+    {
+        std::snprintf(buffer, sizeof(buffer), "%07dPSU", i % 2 ? i : count + i);
+        idText.push_back(buffer);
+    }
+    std::shuffle(idText.begin(), idText.end(), std::mt19937(5));
+    vector<string_view> ids(idText.begin(), idText.end());
+
+    auto start = std::chrono::steady_clock::now();
+    map<string, Student, comparison> treeBody;
+    for (const Student &s : roster)
+        treeBody.insert(pair<string, Student>(s.GetStudentId(), s));
+    double treeBuild = MillisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    size_t treeFound = 0;
+    for (string_view key : ids)
+        treeFound += treeBody.find(string(key)) != treeBody.end();
+    double treeLookup = MillisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    vector<pair<string, Student>> pairs;
+    pairs.reserve(count);
+    for (const Student &s : roster)
+        pairs.emplace_back(s.GetStudentId(), s);
+    FlatMap<string, Student> flatBody(std::move(pairs));
+    double flatBuild = MillisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    size_t flatFound = 0;
+    for (string_view key : ids)
+        flatFound += flatBody.Find(key) != nullptr;
+    double flatLookup = MillisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    vector<const Student *> results;
+    flatBody.FindBatch(ids, results);
+    size_t batchFound = results.size() - std::count(results.begin(), results.end(), nullptr);
+    double batchLookup = MillisecondsSince(start);
+
+    cout << std::fixed << setprecision(1);
+    cout << count << " students, " << ids.size() << " lookups:" << endl;
+    cout << "   map<string, Student, comparison>: build " << treeBuild << " ms, find " << treeLookup
+         << " ms (" << treeFound << " found)" << endl;
+    cout << "   FlatMap<string, Student>:         build " << flatBuild << " ms, Find " << flatLookup
+         << " ms (" << flatFound << " found), FindBatch " << batchLookup << " ms (" << batchFound << " found)" << endl;
+
+    return 0;
+}
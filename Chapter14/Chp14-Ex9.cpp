@@ -0,0 +1,368 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate a columnar (structure-of-arrays) StudentTable as a companion to
+// vector<Student> (Chp14-Ex3.cpp). Each Student field is kept in its own contiguous
+// column, so a scan over one field (such as gpa) touches only that field's bytes rather
+// than dragging whole polymorphic objects (v-table pointer included) through the cache.
+// Rows may be appended in bulk from Student objects and materialized back into Students.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <string_view>
+
+using std::cout;   // preferred to: using namespace std;
+using std::endl;
+using std::setprecision;
+using std::string;
+using std::string_view;
+using std::vector;
+
+class Person
+{
+private: 
+    string firstName;
+    string lastName;
+    char middleInitial;
+    string title;  // Mr., Ms., Mrs., Miss, Dr., etc.
+protected:
+    void ModifyTitle(const string &); 
+public:
+    Person();   // default constructor
+    Person(const string &, const string &, char, const string &);  
+    Person(const Person &);  // copy constructor
+    Person &operator=(const Person &); // overloaded assignment operator
+    virtual ~Person();  // virtual destructor
+
+    // inline function definitions
+    const string &GetFirstName() const { return firstName; }  
+    const string &GetLastName() const { return lastName; }    
+    const string &GetTitle() const { return title; } 
+    char GetMiddleInitial() const { return middleInitial; }
+
+    // Virtual functions will not be inlined since their 
+    // method must be determined at run time using v-table.
+    virtual void Print() const; 
+    virtual void IsA() const;  
+    virtual void Greeting(const string &) const;
+};
+
+Person::Person() : firstName(""), lastName(""), middleInitial('\0'), title("")
+{
+}
+
+Person::Person(const string &fn, const string &ln, char mi, const string &t) :
+               firstName(fn), lastName(ln), middleInitial(mi), title(t)
+{
+}
+
+Person::Person(const Person &p) : firstName(p.firstName), lastName(p.lastName),
+                                  middleInitial(p.middleInitial), title(p.title)
+{
+}
+
+Person::~Person()
+{
+}
+
+Person &Person::operator=(const Person &p)
+{
+   // make sure we're not assigning an object to itself
+   if (this != &p)
+   {
+      // delete any previously dynamically allocated data members here from the destination object
+      // or call ~Person() to release this memory -- unconventional
+
+      // Also, remember to reallocate memory for any data members that are pointers.
+
+      // copy from source to destination object each data member
+      firstName = p.firstName;
+      lastName = p.lastName;
+      middleInitial = p.middleInitial;
+      title = p.title;
+   }
+   return *this;  // allow for cascaded assignments
+}
+
+void Person::ModifyTitle(const string &newTitle)
+{
+    title = newTitle;
+}
+
+void Person::Print() const
+{
+    cout << title << " " << firstName << " ";
+    cout << middleInitial << ". " << lastName << endl;
+}
+
+void Person::IsA() const
+{
+    cout << "Person" << endl;
+}
+
+void Person::Greeting(const string &msg) const
+{
+    cout << msg << endl;
+}
+
+
+class Student : public Person
+{
+private: 
+    float gpa;
+    string currentCourse;
+    string studentId;      // decided to make studentId not const (a design decision that makes copy constuctor more productive, etc.) 
+    static int numStudents;
+public:
+    // member function prototypes
+    Student();  // default constructor
+    Student(const string &, const string &, char, const string &, float, const string &, const string &); 
+    Student(const Student &);  // copy constructor
+    Student &operator=(const Student &); // overloaded assignment operator
+    virtual ~Student();  // destructor
+    void EarnPhD();  
+    // inline function definitions
+    float GetGpa() const { return gpa; }
+    const string &GetCurrentCourse() const { return currentCourse; }
+    const string &GetStudentId() const { return studentId; }
+    void SetCurrentCourse(const string &); // prototype only
+  
+    // In the derived class, the keyword virtual is optional, 
+    // but recommended for internal documentation. Same for override.
+    virtual void Print() const override;
+    virtual void IsA() const override;
+    // note: we choose not to redefine Person::Greeting(const string &); const
+    static int GetNumberStudents() { return numStudents; }
+};
+
+
+int Student::numStudents = 0;  // definition of static data member
+
+
+inline void Student::SetCurrentCourse(const string &c)
+{
+    currentCourse = c;
+}
+
+Student::Student() : gpa(0.0), currentCourse(""), studentId ("None")
+{
+    numStudents++;
+}
+
+Student::Student(const string &fn, const string &ln, char mi, const string &t, float avg, const string &course,
+                 const string &id) : Person(fn, ln, mi, t), gpa(avg), currentCourse(course), studentId(id)
+{
+    numStudents++;
+}
+
+Student::Student(const Student &s) : Person(s), gpa(s.gpa), currentCourse(s.currentCourse), studentId(s.studentId)
+{
+    numStudents++;
+}
+
+// destructor definition
+Student::~Student()
+{
+    numStudents--;
+    // the embedded object studentId will also be destructed
+}
+
+// overloaded assignment operator
+Student &Student::operator=(const Student &s)
+{
+   // make sure we're not assigning an object to itself
+   if (this != &s)
+   {
+      Person::operator=(s);
+
+      // delete any dynamically allocated data members in destination Student (or call ~Student() - unconventional)
+
+      // remember to allocate any memory in destination for copies of source members
+
+      // copy data members from source to desination object
+      gpa = s.gpa;
+      currentCourse = s.currentCourse;
+      studentId = s.studentId;
+
+   }
+   return *this;  // allow for cascaded assignments
+}
+
+void Student::EarnPhD()
+{
+    ModifyTitle("Dr.");
+}
+
+void Student::Print() const
+{   // need to use access functions as these data members are
+    // defined in Person as private
+    cout << GetTitle() << " " << GetFirstName() << " ";
+    cout << GetMiddleInitial() << ". " << GetLastName();
+    cout << " with id: " << studentId << " GPA: ";
+    cout << setprecision(3) <<  " " << gpa;
+    cout << " Course: " << currentCourse << endl;
+}
+
+void Student::IsA() const
+{
+    cout << "Student" << endl;
+}
+
+
+// A StringColumn stores all of its strings end to end in one character buffer; the
+// i-th string occupies bytes [offsets[i], offsets[i + 1]). Compared with a vector<string>,
+// there is no per-string allocation and a scan reads memory strictly in order. Offsets
+// are size_t, so a column may hold as many bytes as a vector<char> can (32-bit offsets
+// would halve their size but wrap silently once a column passed 4 GiB).
+class StringColumn
+{
+private:
+    vector<char> bytes;
+    vector<size_t> offsets {0};
+public:
+    void Reserve(size_t rows, size_t totalBytes) { offsets.reserve(rows + 1); bytes.reserve(totalBytes); }
+    void Append(string_view s)
+    {
+        bytes.insert(bytes.end(), s.begin(), s.end());
+        offsets.push_back(bytes.size());
+    }
+    string_view Get(size_t i) const { return string_view(bytes.data() + offsets[i], offsets[i + 1] - offsets[i]); }
+    size_t Size() const { return offsets.size() - 1; }
+    size_t Bytes() const { return bytes.size(); }
+};
+
+class StudentTable
+{
+private:
+    vector<float> gpa;
+    vector<char> middleInitial;
+    StringColumn firstName;
+    StringColumn lastName;
+    StringColumn title;
+    StringColumn currentCourse;
+    StringColumn studentId;
+public:
+    StudentTable() = default;
+    void Reserve(size_t);
+    void Append(const Student &);
+    void Append(const vector<Student> &);   // bulk append
+    Student GetRow(size_t) const;           // materialize a row as a Student
+    size_t Size() const { return gpa.size(); }
+
+    // column access for scans
+    const float *GpaColumn() const { return gpa.data(); }
+    const vector<char> &MiddleInitialColumn() const { return middleInitial; }
+    const StringColumn &FirstNameColumn() const { return firstName; }
+    const StringColumn &LastNameColumn() const { return lastName; }
+    const StringColumn &TitleColumn() const { return title; }
+    const StringColumn &CurrentCourseColumn() const { return currentCourse; }
+    const StringColumn &StudentIdColumn() const { return studentId; }
+};
+
+void StudentTable::Reserve(size_t rows)
+{
+    gpa.reserve(rows);
+    middleInitial.reserve(rows);
+    firstName.Reserve(rows, rows * 8);    // estimated average field lengths
+    lastName.Reserve(rows, rows * 8);
+    title.Reserve(rows, rows * 3);
+    currentCourse.Reserve(rows, rows * 3);
+    studentId.Reserve(rows, rows * 8);
+}
+
+void StudentTable::Append(const Student &s)
+{
+    gpa.push_back(s.GetGpa());
+    middleInitial.push_back(s.GetMiddleInitial());
+    firstName.Append(s.GetFirstName());
+    lastName.Append(s.GetLastName());
+    title.Append(s.GetTitle());
+    currentCourse.Append(s.GetCurrentCourse());
+    studentId.Append(s.GetStudentId());
+}
+
+// Capacity grows geometrically (at least doubling), so ingesting many small batches
+// copies each column only O(log N) times rather than once per batch
+void StudentTable::Append(const vector<Student> &students)
+{
+    size_t needed = Size() + students.size();
+    if (needed > gpa.capacity())
+        Reserve(std::max(needed, 2 * gpa.capacity()));
+    for (const Student &s : students)
+        Append(s);
+}
+
+Student StudentTable::GetRow(size_t i) const
+{
+    return Student(string(firstName.Get(i)), string(lastName.Get(i)), middleInitial[i],
+                   string(title.Get(i)), gpa[i], string(currentCourse.Get(i)), string(studentId.Get(i)));
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    vector<Student> studentBody;
+    studentBody.push_back(Student("Hana", "Sato", 'U', "Dr.", 3.8, "C++", "178PSU"));
+    studentBody.push_back(Student("Sara", "Kato", 'B', "Dr.", 3.9, "C++", "272PSU"));
+    studentBody.push_back(Student("Giselle", "LeBrun", 'R', "Ms.", 3.4, "C++", "299TU"));
+
+    StudentTable table;
+    table.Append(studentBody);    // bulk append
+    for (size_t i = 0; i < table.Size(); i++)
+        table.GetRow(i).Print();   // materialize each row back into a Student
+
+    // Build a large roster both ways, then scan single fields of each
+    const size_t count = 1000000;
+    const char *courses[] = { "C++", "Java", "Python", "Data Structures" };
+    const char *titles[] = { "Mr.", "Ms.", "Dr." };
+    vector<Student> roster;
+    roster.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        roster.push_back(Student("First" + std::to_string(i % 1000), "Last" + std::to_string(i % 997),
+                                 'A' + i % 26, titles[i % 3], 2.0f + (i % 200) / 100.0f, courses[i % 4],
+                                 std::to_string(100000 + i) + "PSU"));
+    auto start = std::chrono::steady_clock::now();
+    StudentTable bigTable;
+    bigTable.Append(roster);
+    double appendTime = MillisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    double objectSum = 0;
+    for (const Student &s : roster)
+        objectSum += s.GetGpa();
+    double objectGpaTime = MillisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    double columnSum = 0;
+    const float *gpaColumn = bigTable.GpaColumn();
+    for (size_t i = 0; i < bigTable.Size(); i++)
+        columnSum += gpaColumn[i];
+    double columnGpaTime = MillisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t objectCount = 0;
+    for (const Student &s : roster)
+        objectCount += s.GetCurrentCourse() == "C++";
+    double objectCourseTime = MillisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t columnCount = 0;
+    const StringColumn &courseColumn = bigTable.CurrentCourseColumn();
+    for (size_t i = 0; i < courseColumn.Size(); i++)
+        columnCount += courseColumn.Get(i) == "C++";
+    double columnCourseTime = MillisecondsSince(start);
+
+    cout << setprecision(6);
+    cout << "Bulk append of " << count << " Students: " << appendTime << " ms" << endl;
+    cout << "Mean GPA: objects " << objectGpaTime << " ms, column " << columnGpaTime << " ms"
+         << (objectSum == columnSum ? "" : " (MISMATCH)") << endl;
+    cout << "Count in C++: objects " << objectCourseTime << " ms, column " << columnCourseTime << " ms"
+         << (objectCount == columnCount ? "" : " (MISMATCH)") << endl;
+
+    return 0;
+}
@@ -2,11 +2,16 @@
 // Purpose: To illustrate Canonical Class form in a hierarchy of related classes 
 // Explicit default constructor, copy constructor and overloaded assignment operators. And virtual destructor.
 // Extended canonical class form: Adds move copy constructor and move assignment operator
+// The move operations are noexcept, so that containers such as vector move (rather than copy) elements when they grow
+// Special member functions report themselves through Trace.h: compile with -DTRACE_MODE=Off, Count or Log (the default)
 
 #include <iostream>
 #include <iomanip>
+#include <type_traits>
+#include <cstdlib>
 #include <cstring>    // Try not to worry -- We'll need one pointer data member to demonstrate a deep copy and assignment
                       // and a char * will provide a very easy to demonstrate data member for this purpose 
+#include "Trace.h"
 using std::cout;      // preferred to: using namespace std;
 using std::endl;
 using std::setprecision;
@@ -28,7 +33,7 @@ public:
     Person();   // default constructor
     Person(const string &, const string &, char, const char *);  
     Person(const Person &);  // copy constructor
-    Person(Person &&);  // move copy constructor
+    Person(Person &&) noexcept;  // move copy constructor
     virtual ~Person();  // virtual destructor
 
     // inline function definitions
@@ -45,7 +50,7 @@ public:
     virtual void Greeting(const string &) const;
 
     Person &operator=(const Person &);  // overloaded assignment operator prototype
-    Person &operator=(Person &&);  // move overloaded assignment operator prototype
+    Person &operator=(Person &&) noexcept;  // move overloaded assignment operator prototype
 
 };
 
@@ -63,7 +68,7 @@ Person::Person(const string &fn, const string &ln, char mi, const char *t) : fir
 // copy constructor
 Person::Person(const Person &p): firstName(p.firstName), lastName(p.lastName), middleInitial(p.middleInitial)
 {
-    cout << "Person copy constructor" << endl;
+    Trace<Person>(CopyConstructor, "Person copy constructor");
     // be sure to do a deep copy for the pointer data member -- allocate memory, then copy contents
     title = new char [strlen(p.title) + 1];
     strcpy(title, p.title);
@@ -72,23 +77,20 @@ Person::Person(const Person &p): firstName(p.firstName), lastName(p.lastName), m
 // move copy constructor
 // left hand object overtakes the dynamically allocated data members of right hand object
 // Then null out right hand objects pointers (we've relinquished those members). Non-pointer data is just copied.
-// Non-pointer data members (such as string or single char) are simply copied (string ensures a deep copy with =)
-Person::Person(Person &&p)
+// string data members are moved too: the destination takes over the source string's buffer rather than copying it
+Person::Person(Person &&p) noexcept : firstName(move(p.firstName)), lastName(move(p.lastName)),
+                                      middleInitial(p.middleInitial), title(p.title)
 {
-    cout << "Person Move copy constructor" << endl;
-    firstName = p.firstName;    
-    p.firstName = "";     // set source object member to empty string
-    lastName = p.lastName;
-    p.lastName = ""; 
-    middleInitial = p.middleInitial;
+    Trace<Person>(MoveConstructor, "Person Move copy constructor");
+    p.firstName.clear();     // a moved-from string is valid but unspecified; make it empty
+    p.lastName.clear();
     p.middleInitial = '\0';   // set source object member to null character
-    title = p.title;     // here, destinatation pointer takes over source pointer's memory
     p.title = nullptr;         // null out source pointer since memory should not be shared (it now belong to destination object)
 }
 
 Person::~Person()
 {
-    cout << "Person destructor" << endl;
+    Trace<Person>(Destructor, "Person destructor");
     delete title;
 }
 
@@ -135,7 +137,7 @@ void Person::Greeting(const string &msg) const
 // overloaded assignment operator
 Person &Person::operator=(const Person &p)
 {
-   cout << "Person assignment operator" << endl;
+   Trace<Person>(CopyAssignment, "Person assignment operator");
    // make sure we're not assigning an object to itself
    if (this != &p)
    {
@@ -155,9 +157,9 @@ Person &Person::operator=(const Person &p)
 }
 
 // overloaded move assignment operator
-Person &Person::operator=(Person &&p)
+Person &Person::operator=(Person &&p) noexcept
 {
-   cout << "Person move assignment operator" << endl;
+   Trace<Person>(MoveAssignment, "Person move assignment operator");
    // make sure we're not assigning an object to itself
    if (this != &p)
    {
@@ -167,10 +169,10 @@ Person &Person::operator=(Person &&p)
       // Take over rhs object's data members (at least those which are pointers)
       // Once pointer data members are taken over by lhs, null out the rhs object's pointer to them
       // Non-pointer data members can be copied easily via assignment and then set to a zeroed or empty type value
-      firstName = p.firstName;  // assignment between strings will be deep assignment
-      p.firstName = "";         // set source data member to empty string to indicate non-use/existence
-      lastName = p.lastName; 
-      p.lastName = "";
+      firstName = move(p.firstName);  // move assignment between strings takes over the source's buffer
+      p.firstName.clear();            // set source data member to empty string to indicate non-use/existence
+      lastName = move(p.lastName);
+      p.lastName.clear();
       middleInitial = p.middleInitial;
       p.middleInitial = '\0';
       title = p.title;    // with ptr data member, this is a pointer assignemt - destination takes over source object's memory
@@ -193,7 +195,7 @@ public:
     Student(const string &, const string &, char, const char *,
             float, const string &, const char *); 
     Student(const Student &);  // copy constructor
-    Student(Student &&); // move copy constructor
+    Student(Student &&) noexcept; // move copy constructor
     virtual ~Student();  // destructor
     void EarnPhD();  
     // inline function definitions
@@ -208,7 +210,7 @@ public:
     virtual void IsA() const override;
     // note: we choose not to redefine Person::Greeting(const Student &) const
     Student &operator=(const Student &);  // overloaded assignment operator prototype
-    Student &operator=(Student &&);  // overloaded move assignment operator prototype
+    Student &operator=(Student &&) noexcept;  // overloaded move assignment operator prototype
 };
 
 inline void Student::SetCurrentCourse(const string &c)
@@ -232,7 +234,7 @@ Student::Student(const string &fn, const string &ln, char mi, const char *t, flo
 // Copy constructor definition
 Student::Student(const Student &s) : Person(s), gpa(s.gpa), currentCourse(s.currentCourse)
 {
-    cout << "Student copy constructor" << endl;
+    Trace<Student>(CopyConstructor, "Student copy constructor");
     // deep copy of pointer data member (use a temp since data is const and can't be directly copied into)
     char *temp = new char [strlen(s.studentId) + 1];
     strcpy (temp, s.studentId); 
@@ -242,22 +244,20 @@ Student::Student(const Student &s) : Person(s), gpa(s.gpa), currentCourse(s.curr
 // move copy constructor
 // left hand object overtakes the dynamically allocated data memberse of right hand object
 // Then null out right hand objects pointer members (we've relinquished those members). Non-pointer data is just copied.
-Student::Student(Student &&s) : Person(move(s))   // make sure we call base class Move copy constructor
+Student::Student(Student &&s) noexcept : Person(move(s)),   // make sure we call base class Move copy constructor
+                                         gpa(s.gpa), currentCourse(move(s.currentCourse)), studentId(s.studentId)
 {
-    cout << "Student move copy constructor" << endl;
-    gpa = s.gpa;   // copy then
+    Trace<Student>(MoveConstructor, "Student move copy constructor");
     s.gpa = 0.0;   // zero out source object member
-    currentCourse = s.currentCourse;
-    s.currentCourse = ""; 
-    // for ptr data member, destination data member takes over source data member's memory
-    studentId = s.studentId;  // data is constant, pointer is not so assignment is ok
-    s.studentId = nullptr;    // then null out source pointer data member 
+    s.currentCourse.clear();
+    // for ptr data member, destination data member has taken over source data member's memory
+    s.studentId = nullptr;    // so null out source pointer data member
 }
 
 // destructor definition
 Student::~Student()
 {
-    cout << "Student destructor" << endl;
+    Trace<Student>(Destructor, "Student destructor");
     delete (char *) studentId;    // fix cast
 }
 
@@ -297,7 +297,7 @@ void Student::IsA() const
 // overloaded assignment operator
 Student &Student::operator=(const Student &s)
 {
-   cout << "Student assignment operator" << endl;
+   Trace<Student>(CopyAssignment, "Student assignment operator");
    // make sure we're not assigning an object to itself
    if (this != &s)
    {
@@ -319,9 +319,9 @@ Student &Student::operator=(const Student &s)
 }
 
 // overloaded move assignment operator
-Student &Student::operator=(Student &&s)
+Student &Student::operator=(Student &&s) noexcept
 {
-   cout << "Student Move assignment operator" << endl;
+   Trace<Student>(MoveAssignment, "Student Move assignment operator");
    // make sure we're not assigning an object to itself
    if (this != &s)
    {
@@ -335,8 +335,8 @@ Student &Student::operator=(Student &&s)
       // for non-pointer members, an assignment is fine
       gpa = s.gpa;           
       s.gpa = 0.0;  // zero out source objects data member value 
-      currentCourse = s.currentCourse;  // take over memory from pointer data members
-      s.currentCourse = "";
+      currentCourse = move(s.currentCourse);  // take over the source string's buffer
+      s.currentCourse.clear();
       // for ptr data members, destination data member will take over source data member's memory
       studentId = s.studentId;  // this is a pointer assignment    
       s.studentId = nullptr;      // null out source object's data member (so they won't share the memory)
@@ -344,8 +344,15 @@ Student &Student::operator=(Student &&s)
    return *this;  // allow for cascaded assignments
 }
 
+// The guarantee vector relies upon (via std::move_if_noexcept) when it reallocates
+static_assert(std::is_nothrow_move_constructible_v<Student> && std::is_nothrow_move_assignable_v<Student>,
+              "Student moves must be noexcept");
+
 int main()
 {
+    if constexpr (traceMode == TraceMode::Count)   // report once main's local objects are destroyed too
+        std::atexit([] { TraceCounts<Person>::Print("Person"); TraceCounts<Student>::Print("Student"); });
+
     // Show default, copy, assignment operator, and virtual destructor. 
     // Also show move copy and move assignment.
 
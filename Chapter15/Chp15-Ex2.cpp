@@ -1,6 +1,7 @@
 // (c) Dorothy R. Kirk. All Rights Reserved.
 // Purpose: To illustrate items to include in a driver to test a class. 
 // Sample driver to test the Student class. 
+// Compile with: Person.cpp Student.cpp InternTable.cpp RecordBuffer.cpp
 
 #include <iostream>
 #include <iomanip>
@@ -0,0 +1,94 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate interned titles and course names in the Person/Student hierarchy.
+// Equal titles (and courses) share one interned copy, so comparing them is a pointer
+// compare, and constructing, copying or assigning a Student allocates nothing for them.
+// Compile with: Person.cpp Student.cpp InternTable.cpp RecordBuffer.cpp
+
+#include <iostream>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+#include "Person.h"
+#include "Student.h"
+#include "InternTable.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+// Count every heap allocation made by this program (replacing global operator new)
+static std::atomic<long> allocations{0};
+
+void *operator new(std::size_t size)
+{
+    allocations++;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+// std::pmr's default (heap) resource, which studentId comes from, uses the aligned forms
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocations++;
+    if (void *p = std::aligned_alloc(static_cast<std::size_t>(alignment),
+                                     (size + static_cast<std::size_t>(alignment) - 1) & ~(static_cast<std::size_t>(alignment) - 1)))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+int main()
+{
+    Student s1("Jo", "Li", 'H', "Ms.", 3.7, "C++", "UD1234");
+    Student s2("Sam", "Lo", 'A', "Ms.", 3.5, "C++", "UD2245");
+    s1.Print();
+    s2.Print();
+    cout << "Same title object? " << (s1.GetTitle() == s2.GetTitle())
+         << "; same course object? " << (s1.GetCurrentCourse() == s2.GetCurrentCourse()) << endl;
+    s2.EarnPhD();
+    cout << "After EarnPhD, same title object? " << (s1.GetTitle() == s2.GetTitle()) << endl;
+
+    // Several threads intern the same few strings concurrently
+    vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+        threads.emplace_back([] {
+            const char *names[] = { "Mr.", "Ms.", "Dr.", "C++", "Java" };
+            for (int i = 0; i < 100000; i++)
+                InternTable::Intern(names[i % 5]);
+        });
+    for (std::thread &t : threads)
+        t.join();
+    cout << "Distinct interned strings: " << InternTable::Size() << endl;
+
+    // Person and Student trace their special member functions to cout (by default; see Trace.h); mute cout
+    // while bulk-constructing so that only the allocation counts are measured
+    const int count = 100000;
+    vector<Student> roster;
+    roster.reserve(count);
+    cout.setstate(std::ios_base::badbit);
+    long before = allocations.load();
+    for (int i = 0; i < count; i++)
+        roster.emplace_back("Jo", "Li", 'H', (i % 2) ? "Ms." : "Mr.", 3.7, "C++", "UD1234");
+    long constructAllocations = allocations.load() - before;
+    before = allocations.load();
+    vector<Student> copies(roster);
+    long copyAllocations = allocations.load() - before;
+    cout.clear();
+
+    cout << "Heap allocations per Student: construct "
+         << static_cast<double>(constructAllocations) / count << ", copy "
+         << static_cast<double>(copyAllocations) / count
+         << " (only studentId remains; title and course are interned)" << endl;
+    cout << "sizeof(Student): " << sizeof(Student) << " bytes" << endl;
+
+    cout.setstate(std::ios_base::badbit);   // mute destructor tracing on exit
+    return 0;
+}
@@ -0,0 +1,146 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate bulk loading of Students into a monotonic arena (StudentArena.h)
+// compared with the original, heap-allocated Person/Student of this chapter (reproduced below, in
+// namespace original, reduced to construction and destruction): one new and delete per Student, plus
+// a new char[] each for title and studentId. In the arena, every sub-allocation of a batch comes
+// from one buffer and the whole batch is torn down at once.
+// Compile with: Person.cpp Student.cpp InternTable.cpp RecordBuffer.cpp StudentArena.cpp
+// Run as: Chp15-Ex4 [number of students]   (default 10,000,000)
+
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Person.h"
+#include "Student.h"
+#include "StudentArena.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+namespace original
+{
+// Person and Student as Person.cpp and Student.cpp first had them: title and studentId are deep-copied
+// char *s, and currentCourse a std::string. Only what loading and teardown use is kept.
+class Person
+{
+private:
+    std::string firstName;
+    std::string lastName;
+    char middleInitial;
+    char *title;  // Mr., Ms., Mrs., Miss, Dr., etc.
+public:
+    Person(const std::string &fn, const std::string &ln, char mi, const char *t) :
+           firstName(fn), lastName(ln), middleInitial(mi)
+    {
+        // allocate memory for ptr data member, then fill with appropriate value
+        title = new char [strlen(t) + 1];
+        strcpy(title, t);
+    }
+    Person(const Person &) = delete;
+    Person &operator=(const Person &) = delete;
+    virtual ~Person()
+    {
+        cout << "Person destructor" << endl;
+        delete [] title;
+    }
+};
+
+class Student : public Person
+{
+private:
+    float gpa;
+    std::string currentCourse;
+    const char *studentId;
+public:
+    Student(const std::string &fn, const std::string &ln, char mi, const char *t, float avg,
+            const std::string &course, const char *id) : Person(fn, ln, mi, t), gpa(avg), currentCourse(course)
+    {
+        char *temp = new char [strlen(id) + 1];
+        strcpy (temp, id);
+        studentId = temp;
+    }
+    virtual ~Student() override
+    {
+        cout << "Student destructor" << endl;
+        delete [] studentId;
+    }
+};
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    const long count = argc > 1 ? std::atol(argv[1]) : 10000000;
+    const char *firstNames[] = { "Jo", "Sam", "Ren", "Zack", "Gabby", "Juliet", "Alexandria" };
+    const char *lastNames[] = { "Li", "Lo", "Ze", "Moon", "Doone", "Martinez", "Featherstonehaugh" };
+    const char *titles[] = { "Ms.", "Mr.", "Dr." };
+    const char *courses[] = { "C++", "Java", "Data Structures" };
+    char id[24];
+
+    {
+        StudentArena batch;
+        batch.Add("Jo", "Li", 'H', "Ms.", 3.7, "C++", "UD1234");
+        batch.Add("Sam", "Lo", 'A', "Mr.", 3.5, "C++", "UD2245");
+        for (size_t i = 0; i < batch.Size(); i++)
+            batch[i].Print();
+        Student heapCopy(batch[0]);   // copies leave the arena (and so may outlive it)
+        {
+            Student moved(std::move(batch[1]));   // moves do not allocate: moved stays in the arena,
+            moved.Print();                        // so it must be gone before the arena is released
+        }
+        batch.Release();
+        heapCopy.Print();
+    }
+
+    // Person and Student trace their special member functions to cout (by default; see Trace.h); mute cout
+    // while timing so that only construction and teardown are measured
+    cout << "Loading " << count << " students:" << endl;
+    cout.setstate(std::ios_base::badbit);
+
+    // the original classes: each Student, and each of its sub-allocations, comes from the heap
+    auto start = std::chrono::steady_clock::now();
+    vector<original::Student *> roster;
+    roster.reserve(count);
+    for (long i = 0; i < count; i++)
+    {
+        std::snprintf(id, sizeof(id), "UD%ld", i);
+        roster.push_back(new original::Student(firstNames[i % 7], lastNames[i % 7], 'A', titles[i % 3],
+                                               3.5, courses[i % 3], id));
+    }
+    double heapLoad = SecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    for (original::Student *s : roster)
+        delete s;
+    vector<original::Student *>().swap(roster);
+    double heapTeardown = SecondsSince(start);
+
+    // arena mode: one monotonic buffer per batch; teardown releases it in one step
+    start = std::chrono::steady_clock::now();
+    StudentArena batch;
+    batch.Reserve(count);
+    for (long i = 0; i < count; i++)
+    {
+        std::snprintf(id, sizeof(id), "UD%ld", i);
+        batch.Add(firstNames[i % 7], lastNames[i % 7], 'A', titles[i % 3], 3.5, courses[i % 3], id);
+    }
+    double arenaLoad = SecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    batch.Release();
+    double arenaTeardown = SecondsSince(start);
+
+    cout.clear();
+    cout << "   original (heap) Student:       load " << heapLoad << " s, teardown " << heapTeardown << " s" << endl;
+    cout << "   monotonic arena:               load " << arenaLoad << " s, teardown " << arenaTeardown << " s" << endl;
+
+    return 0;
+}
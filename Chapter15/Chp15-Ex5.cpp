@@ -0,0 +1,167 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To measure what true (noexcept, member-wise) move operations buy a vector<Student>,
+// using the Person/Student of Person.cpp and Student.cpp. CopyingStudent (below), whose move
+// operations copy the name strings and are not noexcept, is the comparison. Each is timed in its own process:
+//    g++ -DTRACE_MODE=Off Chp15-Ex5.cpp Person.cpp Student.cpp InternTable.cpp RecordBuffer.cpp
+//    ./a.out before; ./a.out after
+// Tracing is compiled out (TRACE_MODE=Off) so that only the data movement is measured.
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Person.h"
+#include "Student.h"
+#include "InternTable.h"
+#include "Trace.h"
+
+using std::cout;      // preferred to: using namespace std;
+using std::endl;
+using std::vector;
+using std::string;
+
+static_assert(traceMode == TraceMode::Off, "compile every file with -DTRACE_MODE=Off, else tracing is what gets measured");
+
+// CopyingStudent holds what Student holds (pmr name strings, interned title and course, and a
+// studentId of its own) but has the move operations Student first had: they copy the name strings,
+// take over studentId, and are not noexcept -- so vector must copy elements when it grows.
+class CopyingStudent
+{
+private:
+    std::pmr::string firstName;
+    std::pmr::string lastName;
+    char middleInitial;
+    const char *title;
+    float gpa;
+    const char *currentCourse;
+    const char *studentId;
+    static const char *CopyId(const char *id)
+    {
+        char *temp = new char [strlen(id) + 1];
+        strcpy(temp, id);
+        return temp;
+    }
+public:
+    CopyingStudent(const string &fn, const string &ln, char mi, const char *t, float avg,
+                   const string &course, const char *id) :
+                   firstName(fn), lastName(ln), middleInitial(mi), title(InternTable::Intern(t)),
+                   gpa(avg), currentCourse(InternTable::Intern(course)), studentId(CopyId(id)) { }
+    CopyingStudent(const CopyingStudent &s) :
+                   firstName(s.firstName), lastName(s.lastName), middleInitial(s.middleInitial), title(s.title),
+                   gpa(s.gpa), currentCourse(s.currentCourse), studentId(CopyId(s.studentId)) { }
+    CopyingStudent(CopyingStudent &&s) :
+                   firstName(s.firstName), lastName(s.lastName), middleInitial(s.middleInitial), title(s.title),
+                   gpa(s.gpa), currentCourse(s.currentCourse), studentId(s.studentId)
+    {
+        s.firstName = "";
+        s.lastName = "";
+        s.studentId = nullptr;
+    }
+    virtual ~CopyingStudent() { delete [] studentId; }
+    CopyingStudent &operator=(const CopyingStudent &s)
+    {
+        if (this != &s)
+        {
+            firstName = s.firstName;
+            lastName = s.lastName;
+            middleInitial = s.middleInitial;
+            title = s.title;
+            gpa = s.gpa;
+            currentCourse = s.currentCourse;
+            delete [] studentId;
+            studentId = CopyId(s.studentId);
+        }
+        return *this;
+    }
+    CopyingStudent &operator=(CopyingStudent &&s)
+    {
+        if (this != &s)
+        {
+            firstName = s.firstName;
+            s.firstName = "";
+            lastName = s.lastName;
+            s.lastName = "";
+            middleInitial = s.middleInitial;
+            title = s.title;
+            gpa = s.gpa;
+            currentCourse = s.currentCourse;
+            delete [] studentId;
+            studentId = s.studentId;
+            s.studentId = nullptr;
+        }
+        return *this;
+    }
+    const std::pmr::string &GetLastName() const { return lastName; }
+    float GetGpa() const { return gpa; }
+};
+
+static_assert(!std::is_nothrow_move_constructible_v<CopyingStudent>, "vector will copy a CopyingStudent as it grows");
+static_assert(std::is_nothrow_move_constructible_v<Student> && std::is_nothrow_move_assignable_v<Student>,
+              "vector will move a Student as it grows");
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Time growing a vector (no reserve), sorting it by last name then gpa, and random swaps
+template <class StudentType>
+void Measure(const char *label, int count)
+{
+    const char *firstNames[] = { "Jules", "George", "Alexa", "Xander", "Maximiliano-Jose" };
+    const char *lastNames[] = { "Martinez", "Valente", "Gutierrez", "LeBrun", "Featherstonehaugh-Smythe" };
+    const char *titles[] = { "Ms.", "Mr.", "Dr." };
+    const char *courses[] = { "C++", "Adv. C++", "Object-Oriented Design Patterns" };
+    std::mt19937 random(11);
+    char id[16];
+
+    auto start = std::chrono::steady_clock::now();
+    vector<StudentType> roster;
+    for (int i = 0; i < count; i++)
+    {
+        int r = static_cast<int>(random() % 5);
+        std::snprintf(id, sizeof(id), "%dUD", i % 1000000);
+        roster.emplace_back(firstNames[r], lastNames[(r + i) % 5], 'Q', titles[i % 3],
+                            2.0 + (random() % 200) / 100.0f, courses[r % 3], id);
+    }
+    double growth = MillisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    std::sort(roster.begin(), roster.end(), [](const StudentType &a, const StudentType &b) {
+        int order = a.GetLastName().compare(b.GetLastName());
+        return order < 0 || (order == 0 && a.GetGpa() < b.GetGpa());
+    });
+    double sorting = MillisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+        std::swap(roster[random() % count], roster[random() % count]);
+    double swapping = MillisecondsSince(start);
+
+    cout << label << "growth " << growth << " ms, sort " << sorting << " ms, "
+         << count << " swaps " << swapping << " ms" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const int count = 1000000;
+    std::string which = argc > 1 ? argv[1] : "";
+    if (which != "before" && which != "after")
+    {
+        cout << "usage: " << argv[0] << " before|after" << endl;
+        return 1;
+    }
+    cout << count << " students:" << endl;
+    if (which == "before")
+        Measure<CopyingStudent>("before (copying, not noexcept moves): ", count);
+    else
+        Measure<Student>("after (noexcept member-wise moves):   ", count);
+    return 0;
+}
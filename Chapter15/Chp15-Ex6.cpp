@@ -0,0 +1,90 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To compare report generation through Print() (each record streamed to cout, ending in endl)
+// with Print(RecordBuffer &), which formats into a reusable buffer (the GPA via std::to_chars) and
+// writes to a file descriptor in 1MB blocks. Both reports are written to files and compared byte for byte.
+// Compile with: Person.cpp Student.cpp InternTable.cpp RecordBuffer.cpp
+// Run as: Chp15-Ex6 [number of records]   (default 1,000,000)
+
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Person.h"
+#include "Student.h"
+#include "RecordBuffer.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+int SameContents(const char *name1, const char *name2)
+{
+    std::ifstream file1(name1, std::ios::binary), file2(name2, std::ios::binary);
+    return vector<char>(std::istreambuf_iterator<char>(file1), {}) ==
+           vector<char>(std::istreambuf_iterator<char>(file2), {});
+}
+
+int main(int argc, char *argv[])
+{
+    const long count = argc > 1 ? std::atol(argv[1]) : 1000000;
+    const char *printFile = "Chp15-Ex6-print.txt";
+    const char *bufferFile = "Chp15-Ex6-buffered.txt";
+
+    Student s1("Jo", "Li", 'H', "Ms.", 3.7, "C++", "UD1234");
+    Student s2;
+    s2.SetCurrentCourse("Java");
+    s1.Print();
+    s1.Print(RecordBuffer::ForThread());
+    s2.Print();
+    s2.Print(RecordBuffer::ForThread());
+    RecordBuffer::ForThread().Flush();   // RecordBuffer output bypasses cout, so flush both in order
+    cout.flush();
+
+    // A varied roster exercises each branch of Print(); Person and Student trace their special
+    // member functions to cout (by default; see Trace.h), so cout is muted while building it
+    const char *firstNames[] = { "Jo", "Sam", "", "Alexandria" };
+    const char *ids[] = { "UD1234", "GWU4321", "178PSU", "UMD1234567" };
+    const char *courses[] = { "C++", "", "Adv. C++", "Design Patterns" };
+    const float gpas[] = { 3.7f, 0.0f, 3.95f, 2.125f, 4.0f, 3.333f };
+    vector<Student> roster;
+    roster.reserve(count);
+    cout.setstate(std::ios_base::badbit);
+    for (long i = 0; i < count; i++)
+        roster.emplace_back(firstNames[i % 4], (i % 7) ? "Martinez" : "", (i % 5) ? 'M' : '\0',
+                            (i % 3) ? "Dr." : "Ms.", gpas[i % 6], courses[(i / 3) % 4], ids[i % 4]);
+    cout.clear();
+
+    // baseline: Print() to cout, redirected into a file
+    std::ofstream printed(printFile);
+    std::streambuf *console = cout.rdbuf(printed.rdbuf());
+    auto start = std::chrono::steady_clock::now();
+    for (const Student &s : roster)
+        s.Print();
+    double printSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    cout.rdbuf(console);
+    printed.close();
+
+    int fd = open(bufferFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    start = std::chrono::steady_clock::now();
+    {
+        RecordBuffer out(fd);
+        for (const Student &s : roster)
+            s.Print(out);
+    }   // the last partial block is flushed here
+    double bufferSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    close(fd);
+
+    cout << "Records/second: Print() to cout " << static_cast<long>(count / printSeconds)
+         << ", Print(RecordBuffer &) " << static_cast<long>(count / bufferSeconds) << endl;
+    cout << "Reports byte-identical? " << (SameContents(printFile, bufferFile) ? "yes" : "NO") << endl;
+    std::remove(printFile);
+    std::remove(bufferFile);
+
+    cout.setstate(std::ios_base::badbit);   // mute destructor tracing on exit
+    return 0;
+}
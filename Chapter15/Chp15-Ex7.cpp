@@ -0,0 +1,97 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate a persistent, binary form of Student (StudentFile.h). A roster is written once;
+// later runs map the file and view its records in place, so startup does not rebuild any Students.
+// Compile with: Person.cpp Student.cpp InternTable.cpp RecordBuffer.cpp StudentFile.cpp
+// Run as: Chp15-Ex7 [number of students] [file]   (defaults: 20,000,000 and Chp15-Ex7.students)
+
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "Person.h"
+#include "Student.h"
+#include "StudentFile.h"
+
+using std::cout;
+using std::endl;
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    const long count = argc > 1 ? std::atol(argv[1]) : 20000000;
+    const char *path = argc > 2 ? argv[2] : "Chp15-Ex7.students";
+    const char *firstNames[] = { "Jo", "Sam", "Ren", "Zack", "Gabby", "Juliet", "Alexandria" };
+    const char *lastNames[] = { "Li", "Lo", "Ze", "Moon", "Doone", "Martinez", "Featherstonehaugh" };
+    const char *titles[] = { "Ms.", "Mr.", "Dr." };
+    const char *courses[] = { "C++", "Java", "Data Structures" };
+    char id[24];
+
+    // Write the file, one Student at a time (muting the special member tracing of Trace.h)
+    auto start = std::chrono::steady_clock::now();
+    {
+        StudentFileWriter writer(path);
+        cout.setstate(std::ios_base::badbit);
+        if (count > 0)
+            writer.Append(Student());   // a default Student, with its null id and title, round trips too
+        for (long i = 1; i < count; i++)
+        {
+            std::snprintf(id, sizeof(id), "UD%ld", i);
+            writer.Append(Student(firstNames[i % 7], lastNames[i % 7], 'A' + i % 26, titles[i % 3],
+                                  2.0f + (i % 200) / 100.0f, courses[i % 3], id));
+        }
+        cout.clear();
+        if (!writer.Close())
+            cout << "Could not write " << path << endl;
+    }
+    cout << "Wrote " << count << " students in " << MillisecondsSince(start) << " ms" << endl;
+
+    // Startup: map the file; nothing is deserialized
+    start = std::chrono::steady_clock::now();
+    StudentFile roster(path);
+    double openTime = MillisecondsSince(start);
+    if (!roster.IsOpen())
+    {
+        cout << "Could not open " << path << endl;
+        return 1;
+    }
+    cout << "Opened " << roster.Size() << " students in " << openTime << " ms" << endl;
+    if (roster.Size() < 2)   // (the views below need the default Student and at least one more)
+    {
+        std::remove(path);
+        return 0;
+    }
+
+    start = std::chrono::steady_clock::now();
+    StudentRecordView last = roster[roster.Size() - 1];
+    cout << "Last record (viewed in " << MillisecondsSince(start) << " ms): ";
+    last.Print();
+    cout << "First records:" << endl;
+    for (std::size_t i = 0; i < 3 && i < roster.Size(); i++)
+        roster[i].Print();
+
+    Student materialized = roster[1].ToStudent();   // a real Student, when one is needed
+    cout.setstate(std::ios_base::badbit);   // (mute the tracing of its copy/destruction)
+    Student copy(materialized);
+    cout.clear();
+    cout << "As a Student: ";
+    copy.Print();
+
+    start = std::chrono::steady_clock::now();
+    double totalGpa = 0;
+    for (std::size_t i = 0; i < roster.Size(); i++)
+        totalGpa += roster[i].GetGpa();
+    cout << "Average GPA over every record (first touch of the whole file): " << totalGpa / roster.Size()
+         << ", in " << MillisecondsSince(start) << " ms" << endl;
+    start = std::chrono::steady_clock::now();
+    int verified = roster.Verify();
+    cout << "Every string offset within the string heap? " << (verified ? "yes" : "no") << " (checked in "
+         << MillisecondsSince(start) << " ms)" << endl;
+
+    std::remove(path);   // the mapping stays valid until roster is destroyed
+    cout.setstate(std::ios_base::badbit);   // mute destructor tracing on exit
+    return 0;
+}
@@ -0,0 +1,63 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate InternTable.cpp source code
+// Note: lookups share a reader lock, so concurrent interning of already-known strings
+//       (by far the common case -- "Mr.", "Ms.", "Dr.", "C++") does not serialize. A lookup
+//       searches by string_view (C++20 heterogeneous lookup), so only inserting allocates.
+
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_set>
+#include "InternTable.h"
+
+using std::string;
+using std::string_view;
+
+namespace
+{
+    // Hashes a string and a string_view of the same characters alike; is_transparent
+    // (with equal_to<>) lets find() take a string_view without constructing a string
+    struct StringHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(string_view s) const { return std::hash<string_view>()(s); }
+    };
+
+    using StringSet = std::unordered_set<string, StringHash, std::equal_to<>>;
+
+    // unordered_set is node based: a string's characters never move once inserted,
+    // even when the set rehashes, so the c_str() pointers handed out remain valid
+    StringSet &Strings()
+    {
+        static StringSet strings;
+        return strings;
+    }
+
+    std::shared_mutex &Lock()
+    {
+        static std::shared_mutex lock;
+        return lock;
+    }
+}
+
+const char *InternTable::Intern(string_view s)
+{
+    {
+        std::shared_lock<std::shared_mutex> reader(Lock());
+        auto found = Strings().find(s);
+        if (found != Strings().end())
+            return found->c_str();
+    }
+    std::unique_lock<std::shared_mutex> writer(Lock());
+    auto found = Strings().find(s);   // it may have been added meanwhile
+    if (found != Strings().end())
+        return found->c_str();
+    return Strings().emplace(s).first->c_str();
+}
+
+std::size_t InternTable::Size()
+{
+    std::shared_lock<std::shared_mutex> reader(Lock());
+    return Strings().size();
+}
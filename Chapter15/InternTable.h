@@ -0,0 +1,22 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: InternTable header file -- a global, thread-safe pool of interned strings
+
+#ifndef _INTERNTABLE_H
+#define _INTERNTABLE_H
+
+#include <cstddef>
+#include <string_view>
+
+// Intern() returns the one shared copy of a given character sequence. Equal strings
+// always yield the same pointer, so interned strings may be compared by address, and
+// copying one is just copying a pointer. Interned strings live until the program ends.
+class InternTable
+{
+public:
+    static const char *Intern(std::string_view);
+    static const char *Intern(const char *s) { return s ? Intern(std::string_view(s)) : nullptr; }
+    static std::size_t Size();   // number of distinct strings interned so far
+    InternTable() = delete;      // all members are static
+};
+
+#endif
@@ -1,11 +1,18 @@
 // (c) Dorothy R. Kirk. All Rights Reserved.
 // Purpose: To illustrate Person.cpp source code 
-// Note: one pointer data member is present to demonstrate deep copy / deep assignment thoroughly
+// Note: the title pointer data member is interned: the few distinct titles are stored once, in
+//       InternTable, and each Person merely points to one. No deep copy of title is needed.
+//       The name strings are allocated from the memory_resource passed to the alternate
+//       constructor. A copy (as with any pmr container) uses the default resource, so copying is
+//       how a Person leaves an arena. A move-constructed Person keeps its source's resource, so
+//       moving never allocates -- but the new Person must not outlive that resource either.
 
 #include <iostream>
 #include <iomanip>
-#include <cstring>   // we'll generally prefer string, but one char * is used to demonstrate deep copy / deep assignment
 #include "Person.h"
+#include "InternTable.h"
+#include "Trace.h"
+#include "RecordFormat.h"
 
 using std::cout;     // preferred to: using namespace std;
 using std::endl;
@@ -17,72 +24,59 @@ Person::Person() : firstName(""), lastName(""), middleInitial('\0'), title(nullp
 {
 }
 
-Person::Person(const string &fn, const string &ln, char mi, const char *t) : firstName(fn), lastName(ln), middleInitial(mi)
+Person::Person(const string &fn, const string &ln, char mi, const char *t, std::pmr::memory_resource *resource) :
+               firstName(fn, resource), lastName(ln, resource), middleInitial(mi), title(InternTable::Intern(t))
 {
-    // allocate memory for ptr data member, then fill with appropriate value
-    title = new char [strlen(t) + 1];
-    strcpy(title, t);
 }
 
 // copy constructor
 Person::Person(const Person &p): firstName(p.firstName), lastName(p.lastName), middleInitial(p.middleInitial)
 {
-    cout << "Person copy constructor" << endl;
-    // be sure to do a deep copy for the pointer data member -- allocate memory, then copy contents
-    title = new char [strlen(p.title) + 1];
-    strcpy(title, p.title);
+    Trace<Person>(CopyConstructor, "Person copy constructor");
+    title = p.title;   // interned, so sharing the pointer is safe (and free)
 }
 
 // move copy constructor
 // left hand object overtakes the dynamically allocated data members of right hand object
 // Then null out right hand objects pointers (we've relinquished those members). Non-pointer data is just copied.
-// Non-pointer data members (such as string or single char) are simply copied (string ensures a deep copy with =)
-Person::Person(Person &&p)
+// string data members are moved too: a moved pmr string keeps its source's memory_resource and takes over
+// its buffer, so no allocation occurs and nothing can throw -- whichever resource the source Person uses.
+Person::Person(Person &&p) noexcept : firstName(move(p.firstName)), lastName(move(p.lastName)),
+                                      middleInitial(p.middleInitial), title(p.title)   // interned title is shared, not owned
 {
-    cout << "Person Move copy constructor" << endl;
-    firstName = p.firstName;
-    p.firstName = "";     // set source object member to empty string
-    lastName = p.lastName;
-    p.lastName = "";
-    middleInitial = p.middleInitial;
+    Trace<Person>(MoveConstructor, "Person Move copy constructor");
+    p.firstName.clear();     // a moved-from string is valid but unspecified; make it empty
+    p.lastName.clear();
     p.middleInitial = '\0';   // set source object member to null character
-    title = p.title;     // here, destinatation pointer takes over source pointer's memory
-    p.title = nullptr;         // null out source pointer since memory should not be shared (it now belong to destination object)
+    p.title = nullptr;
 }
 
 Person::~Person()
 {
-    cout << "Person destructor" << endl;
-    delete title;
+    Trace<Person>(Destructor, "Person destructor");
+    // title is interned -- it is not owned by this Person, so it is not deleted
 }
 
 void Person::ModifyTitle(const string &newTitle)
 {
-    delete title;  // delete old title
-    title = new char[strlen(newTitle.c_str()) + 1];   // get the c string equivalent from the string
-    strcpy(title, newTitle.c_str());
+    title = InternTable::Intern(newTitle);   // no allocation for a title seen before
 }
 
-const string &Person::SetLastName(const string &ln)
+const std::pmr::string &Person::SetLastName(const string &ln)
 {
     lastName = ln;
     return lastName;
 }
 
+// Both Print()s share one formatter (see RecordFormat.h), so their output is byte-for-byte the same
 void Person::Print() const
 {
-    if (title)
-       cout << title << " ";
-    if (!firstName.empty())
-       cout << firstName << " ";
-    else
-       cout << "No first name ";
-    if (middleInitial != '\0')
-       cout << middleInitial << ". ";
-    if (!lastName.empty())
-       cout << lastName << endl;
-    else
-       cout << "No last name" << endl;
+    FormatPerson(cout, title, firstName, middleInitial, lastName);
+}
+
+void Person::Print(RecordBuffer &out) const
+{
+    FormatPerson(out, title, firstName, middleInitial, lastName);
 }
 
 void Person::IsA() const
@@ -98,45 +92,40 @@ void Person::Greeting(const string &msg) const
 // overloaded assignment operator
 Person &Person::operator=(const Person &p)
 {
-   cout << "Person assignment operator" << endl;
+   Trace<Person>(CopyAssignment, "Person assignment operator");
    // make sure we're not assigning an object to itself
    if (this != &p)
    {
-      // delete memory for dynamically allocated data members
-      delete title;   // or call ~Person(); -- unusual
-
-      // re-allocate memory for pointer data members
       // copy each data member from source to destination object
       firstName = p.firstName;
       lastName = p.lastName;
       middleInitial = p.middleInitial;
-      title = new char [strlen(p.title) + 1];   // mem allocation for ptr member
-      strcpy(title, p.title);
+      title = p.title;   // interned; no re-allocation is necessary
 
    }
    return *this;  // allow for cascaded assignments
 }
 
 // overloaded move assignment operator
-Person &Person::operator=(Person &&p)
+// Between objects using equal memory_resources (e.g. both on the heap, as within a vector) the strings'
+// buffers are taken over and nothing is allocated. Across resources pmr strings must copy instead; that
+// is the one move which allocates, and should that allocation fail the program terminates.
+Person &Person::operator=(Person &&p) noexcept
 {
-   cout << "Person move assignment operator" << endl;
+   Trace<Person>(MoveAssignment, "Person move assignment operator");
    // make sure we're not assigning an object to itself
    if (this != &p)
    {
-      // delete lhs original memory for pointer data members
-      delete title;    // or call ~Person() - unusual
-
       // Take over rhs object's data members (at least those which are pointers)
       // Once pointer data members are taken over by lhs, null out the rhs object's pointer to them
       // Non-pointer data members can be copied easily via assignment and then set to a zeroed or empty type value
-      firstName = p.firstName;  // assignment between strings will be deep assignment
-      p.firstName = "";         // set source data member to empty string to indicate non-use/existence
-      lastName = p.lastName;
-      p.lastName = "";
+      firstName = move(p.firstName);  // move assignment between strings takes over the source's buffer
+      p.firstName.clear();            // set source data member to empty string to indicate non-use/existence
+      lastName = move(p.lastName);
+      p.lastName.clear();
       middleInitial = p.middleInitial;
       p.middleInitial = '\0';
-      title = p.title;    // with ptr data member, this is a pointer assignemt - destination takes over source object's memory
+      title = p.title;    // interned title is shared, not owned
       p.title = nullptr;
    }
    return *this;  // allow for cascaded assignments
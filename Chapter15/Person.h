@@ -4,39 +4,48 @@
 #ifndef _PERSON_H
 #define _PERSON_H
 
+#include <memory_resource>
+#include <string>
+#include "RecordBuffer.h"
+
 using std::string;
 
 class Person
 {
 private:
-    string firstName;
-    string lastName;
+    // pmr strings draw their storage from the memory_resource given at construction
+    // (the heap by default, or e.g. a batch's monotonic arena -- see StudentArena.h)
+    std::pmr::string firstName;
+    std::pmr::string lastName;
     char middleInitial;
-    char *title;  // Mr., Ms., Mrs., Miss, Dr., etc. // we'll keep this data member as a char * to demonstrate deep copy/assignment
+    const char *title;  // Mr., Ms., Mrs., Miss, Dr., etc. -- interned (see InternTable.h), so copies share it
 protected:
     void ModifyTitle(const string &);
+    std::pmr::memory_resource *GetResource() const { return firstName.get_allocator().resource(); }
 public:
     Person();   // default constructor
-    Person(const string &, const string &, char, const char *);
+    Person(const string &, const string &, char, const char *,
+           std::pmr::memory_resource * = std::pmr::get_default_resource());
     Person(const Person &);  // copy constructor
-    Person(Person &&);  // move copy constructor
+    Person(Person &&) noexcept;  // move copy constructor
     virtual ~Person();  // virtual destructor
 
     // inline function definitions
-    const string &GetFirstName() const { return firstName; }
-    const string &GetLastName() const { return lastName; }
+    const std::pmr::string &GetFirstName() const { return firstName; }
+    const std::pmr::string &GetLastName() const { return lastName; }
     const char *GetTitle() const { return title; }
     char GetMiddleInitial() const { return middleInitial; }
 
-    const string &SetLastName(const string &);
+    const std::pmr::string &SetLastName(const string &);
     // Virtual functions will not be inlined since their
     // method must be determined at run time using v-table.
     virtual void Print() const;
+    virtual void Print(RecordBuffer &) const;   // same text as Print(), buffered
     virtual void IsA() const;
     virtual void Greeting(const string &) const;
 
     Person &operator=(const Person &);  // overloaded assignment operator prototype
-    Person &operator=(Person &&);  // move overloaded assignment operator prototype
+    Person &operator=(Person &&) noexcept;  // move overloaded assignment operator prototype
 
 };
 
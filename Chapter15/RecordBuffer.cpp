@@ -0,0 +1,48 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate RecordBuffer.cpp source code
+
+#include <charconv>
+#include <cerrno>
+#include <unistd.h>
+#include "RecordBuffer.h"
+
+RecordBuffer::RecordBuffer(int descriptor, std::size_t size) : fd(descriptor), blockSize(size)
+{
+    buffer.reserve(size + 256);   // room for the record that crosses the block boundary
+}
+
+// Format value in the stream's default (general) notation with the given precision --
+// what cout << setprecision(p) << value produces -- without touching any locale or stream
+RecordBuffer &RecordBuffer::AppendGeneral(double value, int precision)
+{
+    char digits[32];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value,
+                                                std::chars_format::general, precision);
+    buffer.append(digits, result.ptr);
+    return *this;
+}
+
+void RecordBuffer::Flush()
+{
+    const char *next = buffer.data();
+    std::size_t remaining = buffer.size();
+    while (remaining > 0)
+    {
+        ssize_t written = write(fd, next, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;   // as with a failed stream, the output is lost; later records still try
+        }
+        next += written;
+        remaining -= static_cast<std::size_t>(written);
+    }
+    buffer.clear();
+}
+
+RecordBuffer &RecordBuffer::ForThread()
+{
+    thread_local RecordBuffer standardOutput(STDOUT_FILENO);   // flushed as its thread exits
+    return standardOutput;
+}
@@ -0,0 +1,38 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: RecordBuffer header file -- buffered, block-flushed output of formatted records
+
+#ifndef _RECORDBUFFER_H
+#define _RECORDBUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// A RecordBuffer gathers formatted records in memory and writes them to a file descriptor
+// in large blocks, rather than flushing each line as cout << endl does. Blocks are written
+// only at record boundaries (see EndRecord()), so records from several threads' buffers
+// sharing one descriptor never interleave mid-line. A RecordBuffer is not itself thread
+// safe; ForThread() hands each thread its own.
+class RecordBuffer
+{
+private:
+    int fd;
+    std::size_t blockSize;
+    std::string buffer;    // reused: its capacity survives each Flush()
+public:
+    explicit RecordBuffer(int = 1, std::size_t = 1 << 20);   // standard output, 1MB blocks
+    RecordBuffer(const RecordBuffer &) = delete;
+    RecordBuffer &operator=(const RecordBuffer &) = delete;
+    ~RecordBuffer() { Flush(); }
+
+    RecordBuffer &operator<<(std::string_view s) { buffer.append(s); return *this; }
+    RecordBuffer &operator<<(const char *s) { buffer.append(s); return *this; }
+    RecordBuffer &operator<<(char c) { buffer.push_back(c); return *this; }
+    RecordBuffer &AppendGeneral(double, int);   // as an ostream would with setprecision(p)
+    void EndRecord() { if (buffer.size() >= blockSize) Flush(); }
+    void Flush();
+
+    static RecordBuffer &ForThread();   // this thread's buffer for standard output
+};
+
+#endif
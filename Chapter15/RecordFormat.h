@@ -0,0 +1,68 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: RecordFormat header file -- the one definition of the text Person and Student Print(),
+// written to either sink: an ostream (Print()) or a RecordBuffer (Print(RecordBuffer &)). The
+// record views of StudentFile.h format through it too, so all of them stay byte-for-byte alike.
+
+#ifndef _RECORDFORMAT_H
+#define _RECORDFORMAT_H
+
+#include <iostream>
+#include <iomanip>
+#include <string_view>
+#include "RecordBuffer.h"
+
+// The two places the sinks differ: how a gpa is written, and how a record ends
+inline void FormatGpa(std::ostream &out, float gpa) { out << std::setprecision(3) << gpa; }
+inline void FormatGpa(RecordBuffer &out, float gpa) { out.AppendGeneral(gpa, 3); }   // the same digits
+inline void FormatEndOfRecord(std::ostream &out) { out << std::endl; }
+inline void FormatEndOfRecord(RecordBuffer &out) { out << '\n'; out.EndRecord(); }
+
+// A null title is omitted; an empty name is reported as missing
+template <class Sink>
+void FormatPerson(Sink &out, const char *title, std::string_view firstName, char middleInitial,
+                  std::string_view lastName)
+{
+    if (title)
+        out << title << ' ';
+    if (!firstName.empty())
+        out << firstName << ' ';
+    else
+        out << "No first name ";
+    if (middleInitial != '\0')
+        out << middleInitial << ". ";
+    if (!lastName.empty())
+        out << lastName;
+    else
+        out << "No last name";
+    FormatEndOfRecord(out);
+}
+
+template <class Sink>
+void FormatStudent(Sink &out, const char *title, std::string_view firstName, char middleInitial,
+                   std::string_view lastName, const char *studentId, float gpa, const char *currentCourse)
+{
+    if (title)
+        out << title << ' ';
+    if (!firstName.empty())
+        out << firstName << ' ';
+    else
+        out << "No first name ";
+    if (middleInitial != '\0')
+        out << middleInitial << ". ";
+    if (!lastName.empty())
+        out << lastName;
+    if (studentId)
+        out << " with id: " << studentId;
+    if (gpa != 0.0)
+    {
+        out << " GPA:  ";
+        FormatGpa(out, gpa);
+    }
+    if (currentCourse && *currentCourse)
+        out << " Course: " << currentCourse;
+    else
+        out << " No current course";
+    FormatEndOfRecord(out);
+}
+
+#endif
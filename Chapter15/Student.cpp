@@ -4,57 +4,98 @@
 #include <iostream>
 #include <iomanip>
 #include <cstring>
+#include <type_traits>
 #include "Student.h"
+#include "Trace.h"
+#include "RecordFormat.h"
 
 using std::cout;      // preferred to: using namespace std;
 using std::endl;
 using std::setprecision;
 using std::string;
 using std::move;
+using std::size_t;
 
-Student::Student() : gpa(0.0), currentCourse(""), studentId (0)
+Student::Student() : gpa(0.0), currentCourse(nullptr), studentId (0)
 {
 }
 
 // Alternate constructor member function definition
-Student::Student(const string &fn, const string &ln, char mi, const char *t, float avg, const string &course, const char *id) :
-                 Person(fn, ln, mi, t), gpa(avg), currentCourse(course)
+Student::Student(const string &fn, const string &ln, char mi, const char *t, float avg, const string &course, const char *id,
+                 std::pmr::memory_resource *resource) :
+                 Person(fn, ln, mi, t, resource), gpa(avg), currentCourse(InternTable::Intern(course)),
+                 studentId(CopyId(id, resource))
 {
-    char *temp = new char [strlen(id) + 1];
-    strcpy (temp, id);
-    studentId = temp;
 }
 
 // Copy constructor definition
 Student::Student(const Student &s) : Person(s), gpa(s.gpa), currentCourse(s.currentCourse)
 {
-    cout << "Student copy constructor" << endl;
-    // deep copy of pointer data member (use a temp since data is const and can't be directly copied into)
-    char *temp = new char [strlen(s.studentId) + 1];
-    strcpy (temp, s.studentId);
-    studentId = temp;
+    Trace<Student>(CopyConstructor, "Student copy constructor");
+    // deep copy of pointer data member, from the resource our (copied) Person part uses
+    studentId = CopyId(s.studentId, GetResource());
 }
 
 // move copy constructor
 // left hand object overtakes the dynamically allocated data memberse of right hand object
 // Then null out right hand objects pointer members (we've relinquished those members). Non-pointer data is just copied.
-Student::Student(Student &&s) : Person(move(s))   // make sure we call base class Move copy constructor
+// Person's move constructor keeps the source's memory_resource, so studentId is always taken over
+Student::Student(Student &&s) noexcept : Person(move(s)),   // make sure we call base class Move copy constructor
+                                         gpa(s.gpa), currentCourse(s.currentCourse)   // interned; shared rather than owned
 {
-    cout << "Student move copy constructor" << endl;
-    gpa = s.gpa;   // copy then
+    Trace<Student>(MoveConstructor, "Student move copy constructor");
     s.gpa = 0.0;   // zero out source object member
-    currentCourse = s.currentCourse;
-    s.currentCourse = "";
+    s.currentCourse = nullptr;
     // for ptr data member, destination data member takes over source data member's memory
     studentId = s.studentId;  // data is constant, pointer is not so assignment is ok
     s.studentId = nullptr;    // then null out source pointer data member
 }
 
+// The guarantee vector relies upon (via std::move_if_noexcept) when it reallocates. Move construction
+// never allocates; move assignment allocates only between Students on different memory_resources.
+static_assert(std::is_nothrow_move_constructible_v<Student> && std::is_nothrow_move_assignable_v<Student>,
+              "Student moves must be declared noexcept");
+
 // destructor definition
 Student::~Student()
 {
-    cout << "Student destructor" << endl;
-    delete (char *) studentId;    // fix cast
+    Trace<Student>(Destructor, "Student destructor");
+    ReleaseId();
+}
+
+// Allocate a copy of id from the given memory_resource
+const char *Student::CopyId(const char *id, std::pmr::memory_resource *resource)
+{
+    if (!id)
+        return nullptr;
+    size_t length = strlen(id) + 1;
+    char *temp = static_cast<char *>(resource->allocate(length, alignof(char)));
+    memcpy(temp, id, length);
+    return temp;
+}
+
+// Return studentId to the memory_resource it came from (a no-op for a monotonic arena)
+void Student::ReleaseId()
+{
+    if (studentId)
+        GetResource()->deallocate(const_cast<char *>(studentId), strlen(studentId) + 1, alignof(char));
+    studentId = nullptr;
+}
+
+// Take over s's studentId if it came from a resource ours can free it with. Otherwise (for
+// instance, s lives in an arena while we use the heap) copy it and let s release its own.
+void Student::TakeStudentId(Student &s)
+{
+    if (GetResource()->is_equal(*s.GetResource()))
+    {
+        studentId = s.studentId;  // data is constant, pointer is not so assignment is ok
+        s.studentId = nullptr;    // then null out source pointer data member
+    }
+    else
+    {
+        studentId = CopyId(s.studentId, GetResource());
+        s.ReleaseId();
+    }
 }
 
 void Student::EarnPhD()
@@ -62,27 +103,16 @@ void Student::EarnPhD()
     ModifyTitle("Dr.");
 }
 
+// Both Print()s share one formatter (see RecordFormat.h), so their output is byte-for-byte the same.
+// We need to use access functions for the data members defined in Person as private.
 void Student::Print() const
-{   // need to use access functions as these data members are
-    // defined in Person as private
-    if (GetTitle())
-        cout << GetTitle() << " ";
-    if (!GetFirstName().empty())
-        cout << GetFirstName() << " ";
-    else
-        cout << "No first name" << " ";
-    if (GetMiddleInitial() != '\0')
-        cout << GetMiddleInitial() << ". ";
-    if (!GetLastName().empty())
-        cout << GetLastName();
-    if (studentId)
-        cout << " with id: " << studentId;
-    if (gpa != 0.0)
-        cout << " GPA: " << setprecision(3) <<  " " << gpa;
-    if (!currentCourse.empty())
-        cout << " Course: " << currentCourse << endl;
-    else
-        cout << " No current course" << endl;
+{
+    FormatStudent(cout, GetTitle(), GetFirstName(), GetMiddleInitial(), GetLastName(), studentId, gpa, currentCourse);
+}
+
+void Student::Print(RecordBuffer &out) const
+{
+    FormatStudent(out, GetTitle(), GetFirstName(), GetMiddleInitial(), GetLastName(), studentId, gpa, currentCourse);
 }
 
 void Student::IsA() const
@@ -93,49 +123,46 @@ void Student::IsA() const
 // overloaded assignment operator
 Student &Student::operator=(const Student &s)
 {
-   cout << "Student assignment operator" << endl;
+   Trace<Student>(CopyAssignment, "Student assignment operator");
    // make sure we're not assigning an object to itself
    if (this != &s)
    {
       Person::operator=(s);  // call base class operator= for help
 
-      // delete memory for existing destination data members that are pointers
-      delete studentId;
+      // release memory for existing destination data members that are pointers
+      ReleaseId();
 
       // for ptr data members, make a deep assignment -- reallocate memory then copy.
       // for non-ptr data members, an assignment is just fine
       gpa = s.gpa;
       currentCourse = s.currentCourse;
-      // deep copy of pointer data member (use a temp since data is const and can't be directly copied into)
-      char *temp = new char [strlen(s.studentId) + 1];
-      strcpy (temp, s.studentId);
-      studentId = temp;
+      // deep copy of pointer data member
+      studentId = CopyId(s.studentId, GetResource());
    }
    return *this;  // allow for cascaded assignments
 }
 
 // overloaded move assignment operator
-Student &Student::operator=(Student &&s)
+Student &Student::operator=(Student &&s) noexcept
 {
-   cout << "Student Move assignment operator" << endl;
+   Trace<Student>(MoveAssignment, "Student Move assignment operator");
    // make sure we're not assigning an object to itself
    if (this != &s)
    {
       Person::operator=(move(s));  // call base class operator= for help
 
-      // delete lhs original data members that are pointers
-      delete studentId;
+      // release lhs original data members that are pointers
+      ReleaseId();
 
       // Take over rhs object's data members (at least those which are pointers)
       // Once data members are taken over by lhs, null out the rhs object's pointer to them
       // for non-pointer members, an assignment is fine
       gpa = s.gpa;
       s.gpa = 0.0;  // zero out source objects data member value
-      currentCourse = s.currentCourse;  // take over memory from pointer data members
-      s.currentCourse = "";
+      currentCourse = s.currentCourse;  // interned; shared rather than owned
+      s.currentCourse = nullptr;
       // for ptr data members, destination data member will take over source data member's memory
-      studentId = s.studentId;  // this is a pointer assignment
-      s.studentId = nullptr;      // null out source object's data member (so they won't share the memory)
+      TakeStudentId(s);
    }
    return *this;  // allow for cascaded assignments
 }
@@ -5,41 +5,48 @@
 #define _STUDENT_H
 
 #include "Person.h"
+#include "InternTable.h"
 
 class Student : public Person
 {
 private:
     // data members
     float gpa;
-    string currentCourse;
+    const char *currentCourse;   // interned (see InternTable.h); most students share a handful of courses
     const char *studentId;     // Again, we have one pointer data member to demonstrate deep copy / assignment
+                               // (allocated from the same memory_resource as Person's strings)
+    static const char *CopyId(const char *, std::pmr::memory_resource *);
+    void ReleaseId();
+    void TakeStudentId(Student &);
 public:
     // member function prototypes
     Student();  // default constructor
     Student(const string &, const string &, char, const char *,
-            float, const string &, const char *);
+            float, const string &, const char *,
+            std::pmr::memory_resource * = std::pmr::get_default_resource());
     Student(const Student &);  // copy constructor
-    Student(Student &&); // move copy constructor
+    Student(Student &&) noexcept; // move copy constructor
     virtual ~Student();  // destructor
     void EarnPhD();
     // inline function definitions
     float GetGpa() const { return gpa; }
-    const string &GetCurrentCourse() const { return currentCourse; }
+    const char *GetCurrentCourse() const { return currentCourse; }
     const char *GetStudentId() const { return studentId; }
     void SetCurrentCourse(const string &); // prototype only
 
     // In the derived class, the keyword virtual is optional,
     // but recommended for internal documentation
     virtual void Print() const override;
+    virtual void Print(RecordBuffer &) const override;
     virtual void IsA() const override;
     // note: we choose not to redefine Person::Greeting(const Student &) const
     Student &operator=(const Student &);  // overloaded assignment operator prototype
-    Student &operator=(Student &&);  // overloaded move assignment operator prototype
+    Student &operator=(Student &&) noexcept;  // overloaded move assignment operator prototype
 };
 
 inline void Student::SetCurrentCourse(const string &c)
 {
-    currentCourse = c;
+    currentCourse = InternTable::Intern(c);
 }
 
 #endif
@@ -0,0 +1,23 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate StudentArena.cpp source code
+
+#include <new>
+#include "StudentArena.h"
+
+using std::string;
+
+Student *StudentArena::Add(const string &fn, const string &ln, char mi, const char *t,
+                           float avg, const string &course, const char *id)
+{
+    void *memory = arena.allocate(sizeof(Student), alignof(Student));
+    Student *s = new (memory) Student(fn, ln, mi, t, avg, course, id, &arena);
+    students.push_back(s);
+    return s;
+}
+
+// Drop every Student in one step; the pointer vector keeps its (heap) capacity for the next batch
+void StudentArena::Release()
+{
+    students.clear();
+    arena.release();
+}
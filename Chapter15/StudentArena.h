@@ -0,0 +1,42 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: StudentArena header file -- bulk construction of Students from one monotonic arena
+
+#ifndef _STUDENTARENA_H
+#define _STUDENTARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+#include "Student.h"
+
+// Every Student added to a StudentArena -- the object itself, its name strings and its
+// studentId -- is carved from one monotonic_buffer_resource (titles and courses are
+// interned). Nothing is freed one Student at a time: Release() (or the destructor)
+// returns the whole batch in one step, without running the Students' destructors.
+// That is safe because a Student in the arena owns no memory outside of it. So do not
+// delete (or keep pointers to) these Students past Release(); copy one out instead -- a copy
+// uses the default (heap) resource. A move-constructed Student keeps the arena's resource, so
+// it, too, must not outlive Release().
+// The vector of pointers is kept on the heap, outside the arena, so that its outgrown
+// buffers are freed as it grows and it stays valid across Release().
+class StudentArena
+{
+private:
+    std::pmr::monotonic_buffer_resource arena;
+    std::vector<Student *> students;
+public:
+    explicit StudentArena(std::size_t initialSize = 1 << 20) : arena(initialSize) { }
+    StudentArena(const StudentArena &) = delete;   // the Students point into this arena
+    StudentArena &operator=(const StudentArena &) = delete;
+    ~StudentArena() = default;   // the arena's destructor releases every Student at once
+
+    void Reserve(std::size_t n) { students.reserve(n); }
+    Student *Add(const string &, const string &, char, const char *,
+                 float, const string &, const char *);
+    std::size_t Size() const { return students.size(); }
+    Student &operator[](std::size_t i) { return *students[i]; }
+    const Student &operator[](std::size_t i) const { return *students[i]; }
+    void Release();
+};
+
+#endif
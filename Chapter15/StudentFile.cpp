@@ -0,0 +1,173 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate StudentFile.cpp source code
+// Note: a file is not assumed to come from StudentFileWriter: opening checks the header and sizes,
+//       and each string offset is bounds-checked as a record is viewed (or, by Verify(), up front)
+
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "StudentFile.h"
+#include "RecordFormat.h"
+
+using std::cout;
+using std::uint32_t;
+using std::uint64_t;
+
+static const char Magic[8] = "STUDREC";
+constexpr uint32_t Version = 1;
+constexpr uint32_t ByteOrder = 0x01020304;
+
+StudentFileWriter::StudentFileWriter(const char *path) : file(path, std::ios::binary | std::ios::trunc)
+{
+    StudentFileHeader placeholder = {};   // rewritten by Close(), once the counts are known
+    file.write(reinterpret_cast<const char *>(&placeholder), sizeof(placeholder));
+    failed = !file;
+}
+
+uint32_t StudentFileWriter::AddString(const char *s, std::size_t length)
+{
+    if (!s)
+        return StudentRecord::NoString;
+    if (heap.size() + length + 1 >= StudentRecord::NoString)
+    {
+        failed = 1;   // the string heap would outgrow 32-bit offsets
+        return StudentRecord::NoString;
+    }
+    uint32_t offset = static_cast<uint32_t>(heap.size());
+    heap.append(s, length);
+    heap.push_back('\0');
+    return offset;
+}
+
+uint32_t StudentFileWriter::AddInterned(const char *s)
+{
+    if (!s)
+        return StudentRecord::NoString;
+    auto found = internedOffsets.find(s);
+    if (found != internedOffsets.end())
+        return found->second;
+    uint32_t offset = AddString(s, strlen(s));
+    internedOffsets.emplace(s, offset);
+    return offset;
+}
+
+void StudentFileWriter::Append(const Student &s)
+{
+    StudentRecord record = {};
+    record.firstName = AddString(s.GetFirstName().data(), s.GetFirstName().size());
+    record.lastName = AddString(s.GetLastName().data(), s.GetLastName().size());
+    record.title = AddInterned(s.GetTitle());
+    record.currentCourse = AddInterned(s.GetCurrentCourse());
+    record.studentId = s.GetStudentId() ? AddString(s.GetStudentId(), strlen(s.GetStudentId())) : StudentRecord::NoString;
+    record.gpa = s.GetGpa();
+    record.middleInitial = s.GetMiddleInitial();
+    file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+    count++;
+}
+
+int StudentFileWriter::Close()
+{
+    if (!file.is_open())
+        return !failed;
+    StudentFileHeader header = {};
+    memcpy(header.magic, Magic, sizeof(header.magic));
+    header.version = Version;
+    header.byteOrder = ByteOrder;
+    header.headerSize = sizeof(StudentFileHeader);
+    header.recordSize = sizeof(StudentRecord);
+    header.count = count;
+    header.stringHeapOffset = sizeof(StudentFileHeader) + count * sizeof(StudentRecord);
+    header.stringHeapSize = heap.size();
+    file.write(heap.data(), static_cast<std::streamsize>(heap.size()));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.close();
+    failed = failed || !file;
+    heap.clear();
+    heap.shrink_to_fit();
+    return !failed;
+}
+
+StudentFile::StudentFile(const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return;
+    struct stat status;
+    if (fstat(fd, &status) == 0 && static_cast<std::size_t>(status.st_size) >= sizeof(StudentFileHeader))
+    {
+        mappedSize = static_cast<std::size_t>(status.st_size);
+        mapping = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+            mapping = nullptr;
+    }
+    close(fd);   // the mapping remains valid
+    if (!mapping)
+        return;
+
+    const StudentFileHeader *h = static_cast<const StudentFileHeader *>(mapping);
+    const char *base = static_cast<const char *>(mapping);
+    if (memcmp(h->magic, Magic, sizeof(h->magic)) != 0 || h->version != Version || h->byteOrder != ByteOrder ||
+        h->headerSize != sizeof(StudentFileHeader) || h->recordSize != sizeof(StudentRecord) ||
+        h->count > (mappedSize - sizeof(StudentFileHeader)) / sizeof(StudentRecord) ||
+        h->stringHeapOffset != sizeof(StudentFileHeader) + h->count * sizeof(StudentRecord) ||
+        h->stringHeapSize != mappedSize - h->stringHeapOffset ||
+        (h->stringHeapSize > 0 && base[mappedSize - 1] != '\0'))   // so that every string ends in the file
+    {
+        Unmap();   // not a (complete) file of this version
+        return;
+    }
+    header = h;
+    records = reinterpret_cast<const StudentRecord *>(base + sizeof(StudentFileHeader));
+    heap = base + h->stringHeapOffset;
+}
+
+int StudentFile::Verify() const
+{
+    if (!header)
+        return 0;
+    auto valid = [this](uint32_t offset) { return offset == StudentRecord::NoString || offset < header->stringHeapSize; };
+    for (uint64_t i = 0; i < header->count; i++)
+    {
+        const StudentRecord &r = records[i];
+        if (!valid(r.firstName) || !valid(r.lastName) || !valid(r.title) || !valid(r.currentCourse) || !valid(r.studentId))
+            return 0;
+    }
+    return 1;
+}
+
+void StudentFile::Unmap()
+{
+    if (mapping)
+        munmap(mapping, mappedSize);
+    mapping = nullptr;
+    header = nullptr;
+    records = nullptr;
+    heap = nullptr;
+}
+
+// As Student::Print(), through the same formatter (see RecordFormat.h); a null name prints as an empty one
+void StudentRecordView::Print() const
+{
+    const char *firstName = GetFirstName(), *lastName = GetLastName();
+    FormatStudent(cout, GetTitle(), firstName ? firstName : "", GetMiddleInitial(), lastName ? lastName : "",
+                  GetStudentId(), GetGpa(), GetCurrentCourse());
+}
+
+void StudentRecordView::Print(RecordBuffer &out) const
+{
+    const char *firstName = GetFirstName(), *lastName = GetLastName();
+    FormatStudent(out, GetTitle(), firstName ? firstName : "", GetMiddleInitial(), lastName ? lastName : "",
+                  GetStudentId(), GetGpa(), GetCurrentCourse());
+}
+
+Student StudentRecordView::ToStudent() const
+{
+    const char *firstName = GetFirstName(), *lastName = GetLastName(), *course = GetCurrentCourse();
+    return Student(firstName ? firstName : "", lastName ? lastName : "", GetMiddleInitial(), GetTitle(),
+                   GetGpa(), course ? course : "", GetStudentId());
+}
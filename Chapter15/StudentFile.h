@@ -0,0 +1,118 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: StudentFile header file -- a versioned binary file of Student records, read in place via mmap
+
+#ifndef _STUDENTFILE_H
+#define _STUDENTFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include "Student.h"
+#include "RecordBuffer.h"
+
+// File layout (all integers in the writing host's byte order, which byteOrder records):
+//    StudentFileHeader                 64 bytes
+//    StudentRecord[count]              recordSize (32) bytes each, fixed layout
+//    string heap                       stringHeapSize bytes of '\0'-terminated strings
+// A record refers to each of its strings by offset into the string heap. Titles and courses
+// are interned in memory, so each distinct one is stored in the heap just once.
+struct StudentFileHeader
+{
+    char magic[8];              // "STUDREC" and a '\0'
+    std::uint32_t version;
+    std::uint32_t byteOrder;    // 0x01020304 as written
+    std::uint32_t headerSize;
+    std::uint32_t recordSize;
+    std::uint64_t count;
+    std::uint64_t stringHeapOffset;
+    std::uint64_t stringHeapSize;
+    char reserved[16];
+};
+
+struct StudentRecord
+{
+    static constexpr std::uint32_t NoString = 0xFFFFFFFF;   // a null (not merely empty) string
+    std::uint32_t firstName;    // offsets into the string heap
+    std::uint32_t lastName;
+    std::uint32_t title;
+    std::uint32_t currentCourse;
+    std::uint32_t studentId;
+    float gpa;
+    char middleInitial;
+    char reserved[7];
+};
+
+static_assert(sizeof(StudentFileHeader) == 64 && sizeof(StudentRecord) == 32, "the file layout is fixed");
+
+// Writes Students to a new file one at a time; Close() (or the destructor) completes the file.
+// The string heap is held in memory until then, so it is limited to 4GB (offsets are 32 bits).
+class StudentFileWriter
+{
+private:
+    std::ofstream file;
+    std::uint64_t count = 0;
+    std::string heap;
+    std::unordered_map<const char *, std::uint32_t> internedOffsets;   // keyed by interned pointer
+    int failed = 0;
+    std::uint32_t AddString(const char *, std::size_t);
+    std::uint32_t AddInterned(const char *);
+public:
+    explicit StudentFileWriter(const char *);
+    StudentFileWriter(const StudentFileWriter &) = delete;
+    StudentFileWriter &operator=(const StudentFileWriter &) = delete;
+    ~StudentFileWriter() { Close(); }
+    void Append(const Student &);
+    int Close();   // returns 1 if every Student was written successfully
+};
+
+// A read-only, Student-like view of one record; it stays valid as long as its StudentFile is open.
+// Every string offset is bounds-checked against the string heap as it is read, so a corrupt (or
+// hostile) file cannot make a view read outside the mapping: an out-of-range string reads as null.
+class StudentRecordView
+{
+private:
+    const StudentRecord *record;
+    const char *heap;
+    std::uint64_t heapSize;
+    // (StudentFile checked that the heap ends in '\0', so any string starting inside it ends inside it)
+    const char *String(std::uint32_t offset) const { return offset < heapSize ? heap + offset : nullptr; }
+public:
+    StudentRecordView(const StudentRecord *r, const char *h, std::uint64_t size) : record(r), heap(h), heapSize(size) { }
+    const char *GetFirstName() const { return String(record->firstName); }
+    const char *GetLastName() const { return String(record->lastName); }
+    const char *GetTitle() const { return String(record->title); }
+    char GetMiddleInitial() const { return record->middleInitial; }
+    float GetGpa() const { return record->gpa; }
+    const char *GetCurrentCourse() const { return String(record->currentCourse); }
+    const char *GetStudentId() const { return String(record->studentId); }
+    void Print() const;                 // as Student::Print()
+    void Print(RecordBuffer &) const;
+    Student ToStudent() const;          // a full (heap-allocated) Student, when one is needed
+};
+
+// Maps a file made by StudentFileWriter. Opening only checks the header and sizes; records are
+// read (paged in by the operating system) when first viewed. Verify() checks every record's
+// string offsets up front, for a caller who would rather reject a corrupt file than view it.
+class StudentFile
+{
+private:
+    void *mapping = nullptr;
+    std::size_t mappedSize = 0;
+    const StudentFileHeader *header = nullptr;
+    const StudentRecord *records = nullptr;
+    const char *heap = nullptr;
+    void Unmap();
+public:
+    explicit StudentFile(const char *);
+    StudentFile(const StudentFile &) = delete;
+    StudentFile &operator=(const StudentFile &) = delete;
+    ~StudentFile() { Unmap(); }
+    int IsOpen() const { return header != nullptr; }
+    std::size_t Size() const { return header ? header->count : 0; }
+    StudentRecordView operator[](std::size_t i) const { return StudentRecordView(records + i, heap, header->stringHeapSize); }
+    int Verify() const;   // returns 1 if every string offset lies within the string heap (reads every record)
+};
+
+#endif
@@ -0,0 +1,55 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: Trace header file -- a compile-time policy for tracing special member functions
+
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#include <atomic>
+#include <iostream>
+
+// Choose the policy when compiling, e.g. -DTRACE_MODE=Count:
+//   Off   -- Trace() is empty and compiles to nothing
+//   Count -- each call bumps a relaxed atomic counter, kept per class and special member; no I/O
+//   Log   -- (the default) each call writes its message and endl to cout, as before
+// Every translation unit of a program must be compiled with the same mode.
+enum class TraceMode { Off, Count, Log };
+
+#ifndef TRACE_MODE
+#define TRACE_MODE Log
+#endif
+
+constexpr TraceMode traceMode = TraceMode::TRACE_MODE;
+
+enum SpecialMember { CopyConstructor, MoveConstructor, CopyAssignment, MoveAssignment, Destructor, NumSpecialMembers };
+
+template <class Class>
+class TraceCounts
+{
+private:
+    static inline std::atomic<long> counts[NumSpecialMembers] {};
+public:
+    static void Add(SpecialMember member) { counts[member].fetch_add(1, std::memory_order_relaxed); }
+    static long Get(SpecialMember member) { return counts[member].load(std::memory_order_relaxed); }
+    static void Print(const char *);
+    TraceCounts() = delete;   // all members are static
+};
+
+template <class Class>
+void TraceCounts<Class>::Print(const char *className)
+{
+    std::cout << className << ": " << Get(CopyConstructor) << " copy constructions, "
+              << Get(MoveConstructor) << " move constructions, " << Get(CopyAssignment) << " copy assignments, "
+              << Get(MoveAssignment) << " move assignments, " << Get(Destructor) << " destructions" << std::endl;
+}
+
+// Called from Class's special member function 'member'
+template <class Class>
+inline void Trace(SpecialMember member, const char *message)
+{
+    if constexpr (traceMode == TraceMode::Log)
+        std::cout << message << std::endl;
+    else if constexpr (traceMode == TraceMode::Count)
+        TraceCounts<Class>::Add(member);
+}
+
+#endif
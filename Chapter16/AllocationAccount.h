@@ -0,0 +1,124 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: AllocationAccount header file -- heap usage attributed to the class that owns it
+
+#ifndef _ALLOCATIONACCOUNT_H
+#define _ALLOCATIONACCOUNT_H
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+// An AllocationAccount tallies the bytes and allocations charged to one class. A class
+// charges its own instances by routing its class-specific operator new/delete through
+// Allocate()/Free(), and the strings it owns by using NewString()/DeleteString() in place
+// of new char[]/delete. Accounts are meant to be static objects. The constructor is
+// constexpr, so a static account is constant-initialized: it is usable (and its counts
+// are never reset) even by allocations made while other statics are being constructed.
+// An account links itself into a registry when first charged, so that Report() can list
+// live and peak usage for every class which has allocated.
+class AllocationAccount
+{
+private:
+    const char *className;
+    std::atomic<long> liveBytes{0};
+    std::atomic<long> peakBytes{0};
+    std::atomic<long> liveAllocations{0};
+    std::atomic<long> totalAllocations{0};
+    std::atomic<bool> registered{false};
+    AllocationAccount *next = nullptr;     // the next account in the registry
+    static inline std::atomic<AllocationAccount *> registry{nullptr};
+    void Register();
+    void Charge(std::size_t);
+    void Credit(std::size_t);
+public:
+    constexpr explicit AllocationAccount(const char *name) : className(name) { }
+    AllocationAccount(const AllocationAccount &) = delete;
+    AllocationAccount &operator=(const AllocationAccount &) = delete;
+
+    void *Allocate(std::size_t);
+    void Free(void *, std::size_t);
+    char *NewString(const char *);   // a charged copy of s (or nullptr, for a null s)
+    void DeleteString(const char *);
+
+    long GetLiveBytes() const { return liveBytes.load(std::memory_order_relaxed); }
+    long GetPeakBytes() const { return peakBytes.load(std::memory_order_relaxed); }
+    long GetLiveAllocations() const { return liveAllocations.load(std::memory_order_relaxed); }
+    static void Report(std::ostream & = std::cout);
+};
+
+inline void AllocationAccount::Register()
+{
+    bool expected = false;
+    if (!registered.compare_exchange_strong(expected, true))
+        return;   // already registered (perhaps by another thread just now)
+    next = registry.load(std::memory_order_relaxed);
+    while (!registry.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed))
+        ;   // another account registered meanwhile; next now holds it
+}
+
+inline void AllocationAccount::Charge(std::size_t bytes)
+{
+    if (!registered.load(std::memory_order_acquire))
+        Register();
+    long live = liveBytes.fetch_add(static_cast<long>(bytes), std::memory_order_relaxed) + static_cast<long>(bytes);
+    long peak = peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        ;   // another thread raised the peak meanwhile; peak now holds its value
+    liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void AllocationAccount::Credit(std::size_t bytes)
+{
+    liveBytes.fetch_sub(static_cast<long>(bytes), std::memory_order_relaxed);
+    liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+inline void *AllocationAccount::Allocate(std::size_t bytes)
+{
+    void *memory = ::operator new(bytes);
+    Charge(bytes);
+    return memory;
+}
+
+inline void AllocationAccount::Free(void *memory, std::size_t bytes)
+{
+    if (!memory)
+        return;
+    Credit(bytes);
+    ::operator delete(memory);
+}
+
+inline char *AllocationAccount::NewString(const char *s)
+{
+    if (!s)
+        return nullptr;
+    std::size_t length = strlen(s) + 1;
+    char *copy = static_cast<char *>(Allocate(length));
+    memcpy(copy, s, length);
+    return copy;
+}
+
+// The string's length tells us how many bytes to credit back, so it must not have been
+// shortened (e.g. by writing a '\0' into it) since NewString() made it
+inline void AllocationAccount::DeleteString(const char *s)
+{
+    if (s)
+        Free(const_cast<char *>(s), strlen(s) + 1);
+}
+
+inline void AllocationAccount::Report(std::ostream &out)
+{
+    out << std::left << std::setw(16) << "Class" << std::right << std::setw(12) << "Live allocs"
+        << std::setw(12) << "Live bytes" << std::setw(12) << "Peak bytes" << std::setw(14) << "Total allocs" << std::endl;
+    for (const AllocationAccount *account = registry.load(std::memory_order_acquire); account; account = account->next)
+        out << std::left << std::setw(16) << account->className << std::right
+            << std::setw(12) << account->GetLiveAllocations() << std::setw(12) << account->GetLiveBytes()
+            << std::setw(12) << account->GetPeakBytes()
+            << std::setw(14) << account->totalAllocations.load(std::memory_order_relaxed) << std::endl;
+}
+
+#endif
@@ -1,11 +1,14 @@
 // (c) Dorothy R. Kirk. All Rights Reserved.
 // Purpose: To illustrate the Observer Pattern 
+// Heap usage of Course, Person and Student is charged to per-class AllocationAccounts (see
+// AllocationAccount.h) and reported at the end
 
 #include <iostream>
 #include <iomanip>
 #include <cstring>
 #include <list>
 #include <iterator>
+#include "AllocationAccount.h"
 
 using namespace std;
 
@@ -56,7 +59,7 @@ void Subject::Register(Observer *ob)
 
 void Subject::Release(Observer *ob)
 {
-    bool found;
+    bool found = false;
     for (list<Observer *>::iterator iter = observers.begin(); iter != observers.end() && !found; iter++)
     {
         Observer *temp = *iter;
@@ -66,6 +69,7 @@ void Subject::Release(Observer *ob)
             newIter = observers.erase(iter);  
             found = true;  // no need to loop after we've found our desired observer
             numObservers--;
+            break;         // iter was erased, so it must not be advanced
         }
     }
 }
@@ -99,20 +103,25 @@ private:
 public:
     Course(const char *title, int num): number(num)
     {
-        this->title = new char[strlen(title) + 1];
-        strcpy(this->title, title);
+        this->title = account.NewString(title);
         totalStudents = 0;
         for (int i = 0; i < MAXSTUDENTS; i++)
             students[i] = 0;
     }
-    virtual ~Course() { delete title; }  // Don't forget to remove Students from Course!
+    virtual ~Course() { account.DeleteString(title); }  // Don't forget to remove Students from Course!
     int GetCourseNum() const { return number; }
     const char *GetTitle() const { return title; }
     bool AddStudent(Student *);
     void Open() { SetState(1); Notify(); } // Once a course is Open for enrollment, we Notify() the Observers (Students) 
     void PrintStudents();
+
+    static AllocationAccount account;   // Course objects and their titles
+    static void *operator new(size_t size) { return account.Allocate(size); }
+    static void operator delete(void *p, size_t size) { account.Free(p, size); }
 }; 
 
+AllocationAccount Course::account("Course");
+
 bool Course::AddStudent(Student *s) 
 {   
     // should also check to ensure Student isn't already added to Course
@@ -148,8 +157,14 @@ public:
     virtual void Print() const;
     virtual void IsA();  
     virtual void Greeting(const char *);
+
+    static AllocationAccount account;   // Person objects and the strings a Person owns
+    static void *operator new(size_t size) { return account.Allocate(size); }
+    static void operator delete(void *p, size_t size) { account.Free(p, size); }
 };
 
+AllocationAccount Person::account("Person");
+
 Person::Person()
 {
     firstName = lastName = 0;  // NULL pointer
@@ -160,38 +175,31 @@ Person::Person()
 Person::Person(const char *fn, const char *ln, char mi, 
                const char *t)
 {
-    firstName = new char [strlen(fn) + 1];
-    strcpy(firstName, fn);
-    lastName = new char [strlen(ln) + 1];
-    strcpy(lastName, ln);
+    firstName = account.NewString(fn);
+    lastName = account.NewString(ln);
     middleInitial = mi;
-    title = new char [strlen(t) + 1];
-    strcpy(title, t);
+    title = account.NewString(t);
 }
 
 Person::Person(const Person &pers)
 {
-    firstName = new char [strlen(pers.firstName) + 1];
-    strcpy(firstName, pers.firstName);
-    lastName = new char [strlen(pers.lastName) + 1];
-    strcpy(lastName, pers.lastName);
+    firstName = account.NewString(pers.firstName);
+    lastName = account.NewString(pers.lastName);
     middleInitial = pers.middleInitial;
-    title = new char [strlen(pers.title) + 1];
-    strcpy(title, pers.title);
+    title = account.NewString(pers.title);
 }
 
 Person::~Person()
 {
-    delete firstName;
-    delete lastName;
-    delete title;
+    account.DeleteString(firstName);
+    account.DeleteString(lastName);
+    account.DeleteString(title);
 }
 
 void Person::ModifyTitle(const char *newTitle)
 {
-    delete title;  // delete old title
-    title = new char [strlen(newTitle) + 1];
-    strcpy(title, newTitle);
+    account.DeleteString(title);  // delete old title
+    title = account.NewString(newTitle);
 }
 
 void Person::Print() const
@@ -236,8 +244,14 @@ public:
     virtual void Graduate();   // newly introduced virtual fn.
     bool AddCourse(Course *);
     void PrintCourses();
+
+    static AllocationAccount account;   // Student objects and the studentId a Student owns
+    static void *operator new(size_t size) { return account.Allocate(size); }
+    static void operator delete(void *p, size_t size) { account.Free(p, size); }
 };
 
+AllocationAccount Student::account("Student");
+
 
 Student::Student() : studentId (0) 
 {
@@ -250,9 +264,7 @@ Student::Student(const char *fn, const char *ln, char mi,
                  const char *t, float avg, const char *id, Course *c) : Person(fn, ln, mi, t), Observer()
 {
     gpa = avg;
-    char *temp = new char [strlen(id) + 1];
-    strcpy (temp, id); 
-    studentId = temp;
+    studentId = account.NewString(id);
     currentNumCourses = 0;
     waitList = c;   // Set waitlist to Course (Subject) 
     c->Register(this); // Add the Student (Observer) to the Subject's list
@@ -265,9 +277,7 @@ Student::Student(const char *fn, const char *ln, char mi,
                  const char *t, float avg, const char *id) : Person(fn, ln, mi, t), Observer()
 {
     gpa = avg;
-    char *temp = new char [strlen(id) + 1];
-    strcpy (temp, id); 
-    studentId = temp;
+    studentId = account.NewString(id);
     currentNumCourses = 0;
     waitList = 0;   // no Course on waitlist 
     for (int i = 0; i < MAXCOURSES; i++)
@@ -278,7 +288,7 @@ Student::Student(const char *fn, const char *ln, char mi,
 // destructor definition
 Student::~Student()
 {
-    delete (char *) studentId;
+    account.DeleteString(studentId);
     // Add code to remove this Student from the respective course lists
 }
 
@@ -408,6 +418,9 @@ int main()
     delete c2;
     delete c3;
 
+    cout << "Heap usage by class (the Students, on the stack, are still live):" << endl;
+    AllocationAccount::Report();
+
     return 0;
 }
 
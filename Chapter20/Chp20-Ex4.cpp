@@ -0,0 +1,47 @@
+// (c) Dorothy R. Kirk. All Rights Reserved.
+// Purpose: To illustrate per-class allocation accounting (AllocationAccount.h) for the pImpl Person,
+// e.g. to size the memory budget of a large roster
+// To compile: g++ -c PersonImpl.cpp
+//             g++ -c Chp20-Ex4.cpp
+//             g++ -o runme PersonImpl.o Chp20-Ex4.o   (executable is in 'runme')
+
+#include <iostream>
+#include "Person.h"
+#include "AllocationAccount.h"
+
+using namespace std;
+
+const int MAX = 100000;
+
+int main()
+{
+    const char *firstNames[] = { "Giselle", "Zack", "Gabby", "Renee", "Maximiliano" };
+    const char *lastNames[] = { "LeBrun", "Moon", "Doone", "Alexander", "Featherstonehaugh" };
+    const char *titles[] = { "Ms.", "Dr.", "Mr." };
+
+    Person **roster = new Person *[MAX];
+    for (int i = 0; i < MAX; i++)
+        roster[i] = new Person(firstNames[i % 5], lastNames[(i / 5) % 5], 'R', titles[i % 3]);
+    cout << "Roster of " << MAX << " people loaded:" << endl;
+    AllocationAccount::Report();
+
+    // a copy of every other Person, e.g. for a report, raises the peak; assignment churns strings
+    Person **copies = new Person *[MAX / 2];
+    for (int i = 0; i < MAX / 2; i++)
+        copies[i] = new Person(*roster[2 * i]);
+    for (int i = 1; i < MAX; i++)
+        *roster[i] = *roster[i - 1];
+    for (int i = 0; i < MAX / 2; i++)
+        delete copies[i];
+    delete [] copies;
+    cout << "After copying half of the roster, releasing the copies, and assignments:" << endl;
+    AllocationAccount::Report();
+
+    for (int i = 0; i < MAX; i++)
+        delete roster[i];
+    delete [] roster;
+    cout << "After releasing the roster (nothing should remain live):" << endl;
+    AllocationAccount::Report();
+
+    return 0;
+}
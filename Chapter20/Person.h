@@ -4,6 +4,8 @@
 #ifndef _PERSON_H
 #define _PERSON_H
 
+#include <cstddef>
+
 class Person
 {
 private: 
@@ -25,6 +27,11 @@ public:
     virtual void IsA();  
     virtual void Greeting(const char *);
     Person &operator=(const Person &);  // overloaded assignment operator prototype
+
+    // Person objects (and, separately, their PersonImpls) are charged to an AllocationAccount;
+    // see AllocationAccount.h for AllocationAccount::Report()
+    static void *operator new(std::size_t);
+    static void operator delete(void *, std::size_t);
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include <iomanip>
 #include <cstring>
 #include "Person.h"
+#include "AllocationAccount.h"
 
 using namespace std;
 
@@ -30,8 +31,15 @@ public:
     virtual void IsA() { cout << "Person" << endl; }
     virtual void Greeting(const char *msg) { cout << msg << endl; }
     PersonImpl &operator=(const PersonImpl &);  // overloaded assignment operator prototype
+
+    static AllocationAccount account;   // PersonImpl objects and the strings they own
+    static void *operator new(size_t size) { return account.Allocate(size); }
+    static void operator delete(void *p, size_t size) { account.Free(p, size); }
 };
 
+AllocationAccount Person::PersonImpl::account("PersonImpl");
+static AllocationAccount personAccount("Person");   // Person itself holds only pImpl (and its v-ptr)
+
 
 // Nested class member functions
 
@@ -44,38 +52,31 @@ Person::PersonImpl::PersonImpl()
 
 Person::PersonImpl::PersonImpl(const char *fn, const char *ln, char mi, const char *t)
 {
-    firstName = new char [strlen(fn) + 1];
-    strcpy(firstName, fn);
-    lastName = new char [strlen(ln) + 1];
-    strcpy(lastName, ln);
+    firstName = account.NewString(fn);
+    lastName = account.NewString(ln);
     middleInitial = mi;
-    title = new char [strlen(t) + 1];
-    strcpy(title, t);
+    title = account.NewString(t);
 }
 
 Person::PersonImpl::PersonImpl(const Person::PersonImpl &pers) 
 {
-    firstName = new char [strlen(pers.firstName) + 1];
-    strcpy(firstName, pers.firstName);
-    lastName = new char [strlen(pers.lastName) + 1];
-    strcpy(lastName, pers.lastName);
+    firstName = account.NewString(pers.firstName);
+    lastName = account.NewString(pers.lastName);
     middleInitial = pers.middleInitial;
-    title = new char [strlen(pers.title) + 1];
-    strcpy(title, pers.title);
+    title = account.NewString(pers.title);
 }
 
 Person::PersonImpl::~PersonImpl()
 {
-    delete firstName;
-    delete lastName;
-    delete title;
+    account.DeleteString(firstName);
+    account.DeleteString(lastName);
+    account.DeleteString(title);
 }
 
 void Person::PersonImpl::ModifyTitle(const char *newTitle)
 {
-    delete title;  // delete old title
-    title = new char [strlen(newTitle) + 1];
-    strcpy(title, newTitle);
+    account.DeleteString(title);  // delete old title
+    title = account.NewString(newTitle);
 }
 
 void Person::PersonImpl::Print() const
@@ -90,17 +91,14 @@ Person::PersonImpl &Person::PersonImpl::operator=(const PersonImpl &p)
    // make sure we're not assigning an object to itself
    if (this != &p)
    {
-      delete firstName;  // or call ~Person();
-      delete lastName;
-      delete title;
-
-      firstName = new char [strlen(p.firstName) + 1];
-      strcpy(firstName, p.firstName);
-      lastName = new char [strlen(p.lastName) + 1];
-      strcpy(lastName, p.lastName);
+      account.DeleteString(firstName);  // or call ~Person();
+      account.DeleteString(lastName);
+      account.DeleteString(title);
+
+      firstName = account.NewString(p.firstName);
+      lastName = account.NewString(p.lastName);
       middleInitial = p.middleInitial;
-      title = new char [strlen(p.title) + 1];
-      strcpy(title, p.title);
+      title = account.NewString(p.title);
    }
    return *this;  // allow for cascaded assignments
 }
@@ -108,6 +106,16 @@ Person::PersonImpl &Person::PersonImpl::operator=(const PersonImpl &p)
 
 // Person member functions
 
+void *Person::operator new(size_t size)
+{
+    return personAccount.Allocate(size);
+}
+
+void Person::operator delete(void *p, size_t size)
+{
+    personAccount.Free(p, size);
+}
+
 Person::Person() : pImpl(new PersonImpl())
 {
 }